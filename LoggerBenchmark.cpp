@@ -0,0 +1,382 @@
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include "Logger.h"
+#include "SLogger.hpp"
+
+#ifdef _MSC_VER
+#include <io.h>        // _findfirst
+#include <direct.h>    // _mkdir
+#else
+#include <sys/stat.h>
+#include <dirent.h>  // POSIX 文件操作
+#include <unistd.h>  // rmdir
+#endif
+
+// 日志性能测试：1~N个生产者线程，同步/异步Logger与SLogger，16B~4KB消息长度
+// 输出吞吐量、单次调用延迟分位数（p50/p99/p999/max）以及数据写入文件的端到端耗时
+// 用法：LoggerBenchmark [--threads=N] [--count=N] [--format=csv|json] [--out=path] [--keep]
+
+typedef std::chrono::steady_clock BenchClock;
+
+enum class BenchMode {// 测试对象
+	LOGGER_SYNC,
+	LOGGER_ASYNC,
+	SLOGGER
+};
+
+struct BenchConfig {// 测试参数
+	int maxThreads = 4;// 最大生产者线程数
+	size_t count = 20000;// 每组测试的日志总条数
+	bool json = false;// 输出格式：true:JSON；false:CSV
+	bool keep = false;// 是否保留测试生成的日志文件
+	std::string outPath;// 结果输出文件，为空时输出到标准输出
+};
+
+struct BenchResult {// 单组测试结果
+	BenchMode mode;
+	int threads;
+	size_t msgSize;
+	size_t calls;
+	double wallMs;// 生产者总耗时
+	double e2eMs;// 从开始到数据全部写入文件的耗时
+	double opsPerSec;
+	double mbPerSec;
+	uint64_t p50Ns;
+	uint64_t p99Ns;
+	uint64_t p999Ns;
+	uint64_t maxNs;
+};
+
+static const char* BENCH_ROOT = "LoggerBenchmarkLogs";
+static const char* SLOGGER_DIR = "logs";// SLogger默认输出目录
+static const char* SLOGGER_FILE = "logs/log.txt";// SLogger默认输出文件
+static const char* SLOGGER_BACKUP = "logs/log.txt.benchmark";// 测试期间暂存原有的SLogger日志
+static const size_t MSG_SIZES[] = { 16, 64, 256, 1024, 4096 };
+
+// 日志行前缀长度："[yyyy-mm-dd HH:MM:SS.mmm INFO] "
+static const size_t LOGGER_PREFIX_SIZE = 31;
+
+static const char* modeToString(BenchMode mode) {
+	switch (mode) {
+	case BenchMode::LOGGER_SYNC:
+		return "logger-sync";
+	case BenchMode::LOGGER_ASYNC:
+		return "logger-async";
+	case BenchMode::SLOGGER:
+		return "slogger";
+	}
+	return "unknown";
+}
+
+// 创建目录，已存在时忽略，返回是否新建了目录
+static bool makeDirectory(const std::string& path) {
+#ifdef _MSC_VER
+	return _mkdir(path.c_str()) == 0;
+#else
+	return mkdir(path.c_str(), 0755) == 0;
+#endif
+}
+
+// 删除空目录
+static void removeDirectory(const std::string& path) {
+#ifdef _MSC_VER
+	_rmdir(path.c_str());
+#else
+	rmdir(path.c_str());
+#endif
+}
+
+// 遍历目录下的普通文件
+template <typename Func>
+static void forEachFile(const std::string& folder, Func func) {
+#ifdef _MSC_VER
+	std::string searchPath = folder + "\\*";
+	struct _finddata_t fileInfo;
+	intptr_t handle = _findfirst(searchPath.c_str(), &fileInfo);
+	if (handle == -1) {
+		return;
+	}
+	do {
+		if (!(fileInfo.attrib & _A_SUBDIR)) {
+			func(folder + "\\" + fileInfo.name, static_cast<uint64_t>(fileInfo.size));
+		}
+	} while (_findnext(handle, &fileInfo) == 0);
+	_findclose(handle);
+#else
+	DIR* dir = opendir(folder.c_str());
+	if (dir == nullptr) {
+		return;
+	}
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != nullptr) {
+		std::string fullPath = folder + "/" + entry->d_name;
+		struct stat fileStat;
+		if (stat(fullPath.c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode)) {
+			func(fullPath, static_cast<uint64_t>(fileStat.st_size));
+		}
+	}
+	closedir(dir);
+#endif
+}
+
+// 获取目录下所有文件的总大小
+static uint64_t directorySize(const std::string& folder) {
+	uint64_t total = 0;
+	forEachFile(folder, [&total](const std::string&, uint64_t size) {
+		total += size;
+	});
+	return total;
+}
+
+// 删除目录下所有文件
+static void clearDirectory(const std::string& folder) {
+	forEachFile(folder, [](const std::string& path, uint64_t) {
+		remove(path.c_str());
+	});
+}
+
+static bool g_sloggerDirCreated = false;// SLogger输出目录是否由本程序创建
+static bool g_sloggerBackup = false;// 是否暂存了原有的SLogger日志
+
+// 删除SLogger的测试输出并恢复原有日志。SLogger单例在程序退出时才关闭文件，
+// 因此在创建单例之前通过atexit注册，保证在单例析构之后执行
+static void cleanSLoggerOutput() {
+	remove(SLOGGER_FILE);
+	if (g_sloggerBackup) {
+		rename(SLOGGER_BACKUP, SLOGGER_FILE);
+	}
+	if (g_sloggerDirCreated) {
+		removeDirectory(SLOGGER_DIR);
+	}
+}
+
+// 计算分位数（latencies需已排序）
+static uint64_t percentile(const std::vector<uint64_t>& latencies, double p) {
+	if (latencies.empty()) {
+		return 0;
+	}
+	size_t index = static_cast<size_t>(p * latencies.size());
+	if (index >= latencies.size()) {
+		index = latencies.size() - 1;
+	}
+	return latencies[index];
+}
+
+static double elapsedMs(BenchClock::time_point start, BenchClock::time_point stop) {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / 1e6;
+}
+
+// 多线程调用logFunc，记录每次调用的延迟，返回生产者结束时间
+template <typename LogFunc>
+static BenchClock::time_point runProducers(int threads, size_t count, LogFunc logFunc,
+                                           BenchClock::time_point& startTime, std::vector<uint64_t>& latencies) {
+	std::vector<std::vector<uint64_t>> perThread(threads);
+	std::vector<std::thread> workers;
+	std::atomic<int> ready(0);
+	std::atomic<bool> go(false);
+
+	for (int t = 0; t < threads; ++t) {
+		size_t calls = count / threads + (static_cast<size_t>(t) < count % threads ? 1 : 0);
+		perThread[t].reserve(calls);
+		workers.emplace_back([&, t, calls]() {
+			std::vector<uint64_t>& samples = perThread[t];
+			ready++;
+			while (!go) {
+				std::this_thread::yield();
+			}
+			for (size_t i = 0; i < calls; ++i) {
+				auto begin = BenchClock::now();
+				logFunc();
+				auto end = BenchClock::now();
+				samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+			}
+		});
+	}
+
+	// 所有线程就绪后同时开始
+	while (ready < threads) {
+		std::this_thread::yield();
+	}
+	startTime = BenchClock::now();
+	go = true;
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	BenchClock::time_point stopTime = BenchClock::now();
+
+	for (auto& samples : perThread) {
+		latencies.insert(latencies.end(), samples.begin(), samples.end());
+	}
+	return stopTime;
+}
+
+static BenchResult runBenchmark(const BenchConfig& config, BenchMode mode, int threads, size_t msgSize) {
+	const std::string message(msgSize, 'x');
+	std::vector<uint64_t> latencies;
+	latencies.reserve(config.count);
+	BenchClock::time_point startTime;
+	BenchClock::time_point stopTime;
+	BenchClock::time_point diskTime;
+
+	if (mode == BenchMode::SLOGGER) {
+		// SLogger每条日志以std::endl刷新，生产者结束即已写入文件
+		SLogger& logger = SLogger::getInstance();
+		stopTime = runProducers(threads, config.count, [&logger, &message]() {
+			logger.log(message);
+		}, startTime, latencies);
+		diskTime = stopTime;
+	}
+	else {
+		std::string folder = std::string(BENCH_ROOT) + "/" + modeToString(mode) + "_" +
+		                     std::to_string(threads) + "_" + std::to_string(msgSize);
+		makeDirectory(folder);
+		clearDirectory(folder);
+
+		// 至少写入的字节数（换行按1字节计）
+		uint64_t expectedBytes = static_cast<uint64_t>(config.count) * (LOGGER_PREFIX_SIZE + msgSize + 1);
+		Logger logger(folder, Logger::LogLevel::LOG_INFO, false, mode == BenchMode::LOGGER_ASYNC, 1);
+		stopTime = runProducers(threads, config.count, [&logger, &message]() {
+			logger.log(message, Logger::LogLevel::LOG_INFO);
+		}, startTime, latencies);
+
+		// 等待异步线程将数据全部写入文件（最多等待60s）
+		diskTime = stopTime;
+		while (directorySize(folder) < expectedBytes) {
+			diskTime = BenchClock::now();
+			if (elapsedMs(stopTime, diskTime) > 60000) {
+				std::cerr << "Timeout waiting for " << folder << " to be flushed" << std::endl;
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+		diskTime = BenchClock::now();
+		if (!config.keep) {
+			clearDirectory(folder);
+		}
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+
+	BenchResult result;
+	result.mode = mode;
+	result.threads = threads;
+	result.msgSize = msgSize;
+	result.calls = latencies.size();
+	result.wallMs = elapsedMs(startTime, stopTime);
+	result.e2eMs = elapsedMs(startTime, diskTime);
+	double seconds = result.wallMs > 0 ? result.wallMs / 1000.0 : 1e-9;
+	result.opsPerSec = result.calls / seconds;
+	result.mbPerSec = result.calls * static_cast<double>(msgSize) / (1024.0 * 1024.0) / seconds;
+	result.p50Ns = percentile(latencies, 0.50);
+	result.p99Ns = percentile(latencies, 0.99);
+	result.p999Ns = percentile(latencies, 0.999);
+	result.maxNs = latencies.empty() ? 0 : latencies.back();
+	return result;
+}
+
+static void writeCsv(std::ostream& os, const std::vector<BenchResult>& results) {
+	os << "mode,threads,msg_size,calls,wall_ms,e2e_ms,ops_per_sec,mb_per_sec,p50_ns,p99_ns,p999_ns,max_ns" << std::endl;
+	for (const auto& r : results) {
+		os << modeToString(r.mode) << ',' << r.threads << ',' << r.msgSize << ',' << r.calls << ','
+		   << r.wallMs << ',' << r.e2eMs << ',' << r.opsPerSec << ',' << r.mbPerSec << ','
+		   << r.p50Ns << ',' << r.p99Ns << ',' << r.p999Ns << ',' << r.maxNs << std::endl;
+	}
+}
+
+static void writeJson(std::ostream& os, const std::vector<BenchResult>& results) {
+	os << "[" << std::endl;
+	for (size_t i = 0; i < results.size(); ++i) {
+		const BenchResult& r = results[i];
+		os << "  {\"mode\": \"" << modeToString(r.mode) << "\", \"threads\": " << r.threads
+		   << ", \"msg_size\": " << r.msgSize << ", \"calls\": " << r.calls
+		   << ", \"wall_ms\": " << r.wallMs << ", \"e2e_ms\": " << r.e2eMs
+		   << ", \"ops_per_sec\": " << r.opsPerSec << ", \"mb_per_sec\": " << r.mbPerSec
+		   << ", \"p50_ns\": " << r.p50Ns << ", \"p99_ns\": " << r.p99Ns
+		   << ", \"p999_ns\": " << r.p999Ns << ", \"max_ns\": " << r.maxNs << "}"
+		   << (i + 1 < results.size() ? "," : "") << std::endl;
+	}
+	os << "]" << std::endl;
+}
+
+static bool parseArgs(int argc, char* argv[], BenchConfig& config) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg.compare(0, 10, "--threads=") == 0) {
+			config.maxThreads = std::max(1, atoi(arg.c_str() + 10));
+		}
+		else if (arg.compare(0, 8, "--count=") == 0) {
+			config.count = std::max(1L, atol(arg.c_str() + 8));
+		}
+		else if (arg == "--format=json") {
+			config.json = true;
+		}
+		else if (arg == "--format=csv") {
+			config.json = false;
+		}
+		else if (arg.compare(0, 6, "--out=") == 0) {
+			config.outPath = arg.substr(6);
+		}
+		else if (arg == "--keep") {
+			config.keep = true;
+		}
+		else {
+			std::cerr << "Usage: " << argv[0]
+			          << " [--threads=N] [--count=N] [--format=csv|json] [--out=path] [--keep]" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	BenchConfig config;
+	if (!parseArgs(argc, argv, config)) {
+		return 1;
+	}
+
+	makeDirectory(BENCH_ROOT);
+	g_sloggerDirCreated = makeDirectory(SLOGGER_DIR);
+	if (!config.keep) {
+		// 原有的SLogger日志先移开，测试结束后删除测试输出再移回
+		g_sloggerBackup = rename(SLOGGER_FILE, SLOGGER_BACKUP) == 0;
+		atexit(cleanSLoggerOutput);
+	}
+
+	// 线程数按1,2,4...递增，最后一组为maxThreads
+	std::vector<int> threadCounts;
+	for (int t = 1; t < config.maxThreads; t *= 2) {
+		threadCounts.push_back(t);
+	}
+	threadCounts.push_back(config.maxThreads);
+
+	const BenchMode modes[] = { BenchMode::LOGGER_SYNC, BenchMode::LOGGER_ASYNC, BenchMode::SLOGGER };
+	std::vector<BenchResult> results;
+	for (BenchMode mode : modes) {
+		for (int threads : threadCounts) {
+			for (size_t msgSize : MSG_SIZES) {
+				std::cerr << "Running " << modeToString(mode) << " threads=" << threads
+				          << " size=" << msgSize << std::endl;
+				results.push_back(runBenchmark(config, mode, threads, msgSize));
+			}
+		}
+	}
+
+	if (config.outPath.empty()) {
+		config.json ? writeJson(std::cout, results) : writeCsv(std::cout, results);
+	}
+	else {
+		std::ofstream out(config.outPath.c_str(), std::ios::out | std::ios::trunc);
+		config.json ? writeJson(out, results) : writeCsv(out, results);
+	}
+	return 0;
+}
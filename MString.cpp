@@ -1,32 +1,139 @@
 #include "MString.h"
+#include "MStringSimd.h"
+#include "MStringMatcher.h"
+#include "MStringCodec.h"
 #include <cstdarg>
+#include <cstdio>
 #include <iomanip>
 #include <chrono>
-#ifdef _MSC_VER
-#include <cctype>
-#endif // _MSC_VER
 
+const size_t MString::SMALL_CAPACITY;
+const size_t MString::HEAP_FLAG;
+const size_t MString::ALLOCATOR_FLAG;
+const size_t MString::MONOTONIC_FLAG;
+const size_t MString::FLAG_MASK;
+const size_t MString::ALLOCATOR_HEADER;
+
+// 分配堆缓冲区，capacity不含结尾'\0'；自定义分配器的缓冲区在数据之前保存分配器指针
+char* MString::allocate(size_t capacity, MStringAllocator* allocator) {
+    if (allocator == nullptr) {
+        return new char[capacity + 1];
+    }
+    char* block = static_cast<char*>(allocator->allocate(ALLOCATOR_HEADER + capacity + 1));
+    std::memcpy(block, &allocator, sizeof(allocator));
+    return block + ALLOCATOR_HEADER;
+}
+
+// 释放堆缓冲区
+void MString::deallocate(char* data, size_t capacity, MStringAllocator* allocator) {
+    if (allocator == nullptr) {
+        delete[] data;
+        return;
+    }
+    allocator->deallocate(data - ALLOCATOR_HEADER, ALLOCATOR_HEADER + capacity + 1);
+}
+
+// 缓冲区所属的分配器
+MStringAllocator* MString::allocator() const {
+    if (isSmall() || (heap_.cap & ALLOCATOR_FLAG) == 0) {
+        return nullptr;
+    }
+    MStringAllocator* allocator;
+    std::memcpy(&allocator, heap_.data - ALLOCATOR_HEADER, sizeof(allocator));
+    return allocator;
+}
+
+// 初始化为长度为len的未填充字符串（不释放原有资源），返回可写数据指针
+char* MString::initLength(size_t len) {
+    if (len <= SMALL_CAPACITY) {
+        small_[len] = '\0';
+        small_[SMALL_CAPACITY] = static_cast<char>(SMALL_CAPACITY - len);
+        return small_;
+    }
+    setHeap(allocate(len, nullptr), len, len, nullptr);
+    return heap_.data;
+}
+
+// 设置长度并写入结尾'\0'，len不能超过容量
+void MString::setLength(size_t len) {
+    if (isSmall()) {
+        small_[len] = '\0';
+        small_[SMALL_CAPACITY] = static_cast<char>(SMALL_CAPACITY - len);
+    } else {
+        heap_.data[len] = '\0';
+        heap_.len = len;
+    }
+}
+
+// 释放堆存储：单调分配器的缓冲区由分配器整体回收，此时缓冲区可能已失效，不能访问
+void MString::release() {
+    if (!isSmall()) {
+        if ((heap_.cap & MONOTONIC_FLAG) == 0) {
+            deallocate(heap_.data, capacity(), allocator());
+        }
+        initEmpty();
+    }
+}
+
+// 替换为指定内容，容量足够时复用原缓冲区
+void MString::assign(const char* s, size_t len) {
+    if (len <= capacity()) {
+        char* data = mutableData();
+        std::memmove(data, s, len);// s可能指向自身缓冲区
+        setLength(len);
+        return;
+    }
+    MStringAllocator* alloc = allocator();
+    if (alloc == nullptr) {
+        MString temp(s, len);
+        *this = std::move(temp);
+        return;
+    }
+    MString temp(MStringView(s, len), alloc);// 沿用原分配器
+    *this = std::move(temp);
+}
 
 // 构造函数
 MString::MString(const char* s) noexcept {
-    len_ = strlen(s);
-    std::unique_ptr<char[]> temp = std::move(data_); // 将data的所有权转,超出范围自动释放
-    data_.reset(new char[len_ + 1]);
-    strcpy_s(data_.get(), len_, s);
+    if (s == nullptr) {
+        s = "";
+    }
+    size_t len = strlen(s);
+    std::memcpy(initLength(len), s, len);
+}
+
+// 构造函数：指定长度，s中可包含'\0'
+MString::MString(const char* s, size_t len) noexcept {
+    std::memcpy(initLength(len), s, len);
+}
+
+// 构造函数：拷贝视图内容
+MString::MString(MStringView view) noexcept {
+    std::memcpy(initLength(view.length()), view.data(), view.length());
+}
+
+// 构造函数：使用指定分配器，容量至少为内联容量，避免短字符串追加时频繁扩容
+MString::MString(MStringView view, MStringAllocator* allocator) {
+    if (allocator == nullptr) {
+        std::memcpy(initLength(view.length()), view.data(), view.length());
+        return;
+    }
+    size_t capacity = view.length() > SMALL_CAPACITY ? view.length() : SMALL_CAPACITY;
+    char* data = allocate(capacity, allocator);
+    std::memcpy(data, view.data(), view.length());
+    setHeap(data, view.length(), capacity, allocator);
 }
 
 // 拷贝构造函数
 MString::MString(const MString& other) noexcept {
-    len_ = other.len_;
-    std::unique_ptr<char[]> temp = std::move(data_); // 将data的所有权转,超出范围自动释放
-    data_.reset(new char[len_ + 1]);
-    strcpy_s(data_.get(), len_, other.data_.get());
+    size_t len = other.length();
+    std::memcpy(initLength(len), other.getData(), len);
 }
 
 // 移动构造函数
-MString::MString(MString&& other) noexcept
-        : data_(std::move(other.data_)), len_(other.len_) {
-    other.len_ = 0; // 重置源对象的长度
+MString::MString(MString&& other) noexcept {
+    std::memcpy(small_, other.small_, sizeof(small_));// 直接接管内联数据或堆指针
+    other.initEmpty(); // 重置源对象
 }
 
 // 拷贝赋值运算符
@@ -34,400 +141,389 @@ MString& MString::operator=(const MString& other) noexcept {
     if (this == &other) {  // 处理自我赋值
         return *this;
     }
-
-    // 释放原有资源
-    std::unique_ptr<char[]> temp = std::move(data_); // 将data的所有权转,超出范围自动释放
-
-    // 分配新的内存并拷贝数据
-    len_ = other.len_;
-    data_.reset(new char[len_ + 1]);
-    strcpy_s(data_.get(), len_, other.data_.get());
-
+    assign(other.getData(), other.length());
     return *this;  // 返回当前对象的引用，以支持链式赋值
 }
 
 // 移动赋值操作符
 MString& MString::operator=(MString&& other) noexcept {
     if (this != &other) {
-        data_ = std::move(other.data_); // 使用std::move转移智能指针的所有权
-        len_ = other.len_;
-        other.len_ = 0; // 重置源对象的长度
+        release();
+        std::memcpy(small_, other.small_, sizeof(small_));
+        other.initEmpty(); // 重置源对象
     }
     return *this;
 }
 
 // 析构函数
 MString::~MString() {
-}
-
-// 添加 c_str() 方法
-const char* MString::getData() const {
-    return data_.get();
+    release();
 }
 
 // std::string -> MString
 MString MString::fromStdString(const std::string& str) {
-    return MString(str.c_str());
+    return MString(str.data(), str.size());
 }
 
 // MString -> std::string
 std::string MString::toStdString() const {
-    return std::string(this->getData());
-}
-
-// 字符串连接
-MString MString::operator+(const MString& other) const {
-    size_t newLength = len_ + other.len_;
-    std::unique_ptr<char[]> newData(new char[newLength + 1]);
-    strcpy_s(newData.get(), newLength, data_.get());
-    strcat_s(newData.get(), newLength, other.data_.get());
-
-    MString newString(newData.get());
-    return newString;
+    return std::string(getData(), length());
 }
 
 // += 运算符重载，支持 const char* 类型
 MString& MString::operator+=(const char* str) {
-    size_t strLen = strlen(str);
-    size_t newLen = len_ + strLen;
+    return append(str, strlen(str));
+}
 
-    // 为新字符串分配内存
-    std::unique_ptr<char[]> newData(new char[newLen + 1]);
+// += 运算符重载，支持视图
+MString& MString::operator+=(MStringView view) {
+    return append(view.data(), view.length());
+}
 
-    // 拷贝原始数据和附加的字符串
-    strcpy_s(newData.get(), newLen, data_.get());
-    strcat_s(newData.get(), newLen, str);
+// += 运算符重载，支持 char 类型
+MString& MString::operator+=(char c) {
+    return append(c);
+}
+
+// 接管allocator分配的堆缓冲区（不释放原有资源）
+void MString::setHeap(char* data, size_t len, size_t capacity, MStringAllocator* allocator) {
+    data[len] = '\0';
+    heap_.data = data;
+    heap_.len = len;
+    heap_.cap = capacity | HEAP_FLAG;
+    if (allocator != nullptr) {
+        heap_.cap |= allocator->isMonotonic() ? (ALLOCATOR_FLAG | MONOTONIC_FLAG) : ALLOCATOR_FLAG;
+    }
+}
 
-    // 更新数据和长度
-    data_ = std::move(newData);
-    len_ = newLen;
+// 追加时的扩容策略：至少翻倍，摊还O(1)
+size_t MString::growCapacity(size_t minCapacity) const {
+    size_t doubled = capacity() * 2;
+    return doubled > minCapacity ? doubled : minCapacity;
+}
 
+// 预留容量，避免多次追加时重复分配
+void MString::reserve(size_t capacity) {
+    if (capacity <= this->capacity()) {
+        return;
+    }
+    size_t len = length();
+    MStringAllocator* alloc = allocator();
+    char* data = allocate(capacity, alloc);
+    std::memcpy(data, getData(), len);
+    release();
+    setHeap(data, len, capacity, alloc);
+}
+
+// 追加指定长度的数据，容量不足时按几何增长扩容
+MString& MString::append(const char* s, size_t len) {
+    size_t oldLen = length();
+    if (len > capacity() - oldLen) {
+        // 先拷贝到新缓冲区再释放旧缓冲区，s指向自身时依然有效
+        size_t newCapacity = growCapacity(oldLen + len);
+        MStringAllocator* alloc = allocator();
+        char* data = allocate(newCapacity, alloc);
+        std::memcpy(data, getData(), oldLen);
+        std::memcpy(data + oldLen, s, len);
+        release();
+        setHeap(data, oldLen + len, newCapacity, alloc);
+        return *this;
+    }
+    std::memcpy(mutableData() + oldLen, s, len);
+    setLength(oldLen + len);
     return *this;
 }
 
-// 获取长度
-size_t MString::length() const {
-    return len_;
+// 追加单个字符
+MString& MString::append(char c) {
+    return append(&c, 1);
 }
 
 // 字符串比较
-int MString::compareTo(const MString& other) const {
-    return strcmp(data_.get(), other.data_.get());
+int MString::compareTo(MStringView other) const {
+    return view().compareTo(other);
+}
+
+// 忽略ASCII大小写比较
+int MString::compareIgnoreCase(MStringView other) const {
+    return view().compareIgnoreCase(other);
+}
+
+// 忽略ASCII大小写判断是否相等
+bool MString::equalsIgnoreCase(MStringView other) const {
+    return view().equalsIgnoreCase(other);
 }
 
 // 字符串查找
-int MString::indexOf(const char* substr) const {
+int MString::indexOf(MStringView substr) const {
     return find(substr);
 }
 
 // 字符串反向查找
-int MString::lastIndexOf(const char* substr) const {
+int MString::lastIndexOf(MStringView substr) const {
     return rfind(substr);
 }
 
-// 字符串替换
-MString MString::replace(const char* find, const char* replace) const {
-    std::string result = data_.get();
-    size_t pos = 0;
-    while ((pos = result.find(find, pos)) != std::string::npos) {
-        result.replace(pos, strlen(find), replace);
-        pos += strlen(replace);
+// 字符串替换：先统计匹配次数计算结果长度，分配一次内存后逐段拷贝
+MString MString::replace(MStringView find, MStringView replace) const {
+    const char* data = getData();
+    const size_t len = length();
+    if (find.isEmpty()) {
+        return *this;
+    }
+
+    // 统计不重叠的匹配次数
+    size_t count = 0;
+    for (const char* pos = data; (pos = MStringSimd::find(pos, data + len - pos, find.data(), find.length())) != nullptr;
+         pos += find.length()) {
+        count++;
     }
-    return MString(result.c_str());
+    if (count == 0) {
+        return *this;
+    }
+
+    MString result;
+    char* out = result.initLength(len - count * find.length() + count * replace.length());
+    const char* copied = data;
+    for (size_t i = 0; i < count; ++i) {
+        const char* pos = MStringSimd::find(copied, data + len - copied, find.data(), find.length());
+        memcpy(out, copied, pos - copied);
+        out += pos - copied;
+        memcpy(out, replace.data(), replace.length());
+        out += replace.length();
+        copied = pos + find.length();
+    }
+    memcpy(out, copied, data + len - copied);
+    return result;
+}
+
+// 批量替换
+MString MString::replace(const std::vector<std::pair<MStringView, MStringView>>& replacements) const {
+    std::vector<MStringView> finds;
+    std::vector<MStringView> replaces;
+    finds.reserve(replacements.size());
+    replaces.reserve(replacements.size());
+    for (const auto& item : replacements) {
+        finds.push_back(item.first);
+        replaces.push_back(item.second);
+    }
+    return MStringMatcher(finds).replaceAll(view(), replaces);
 }
 
 // 字符串分割
-std::vector<MString> MString::split(const char* delimiter) const {
+std::vector<MString> MString::split(MStringView delimiter) const {
     std::vector<MString> parts;
-    char* context = nullptr;
-    char* token = strtok_s(data_.get(), delimiter, &context);
-    while (token != nullptr) {
+    for (const auto& token : view().splitAnyOf(delimiter, false)) {
         parts.push_back(MString(token));
-        token = strtok_s(nullptr, delimiter, &context);
     }
     return parts;
 }
 
-// 字符串拼接
-MString MString::join(const std::vector<MString>& strings, const MString& separator) {
-    std::string result;
-    if (!strings.empty()) {
-        result.append(strings[0].data_.get());  // 添加第一个元素
-        for (size_t i = 1; i < strings.size(); i++) {
-            result.append(separator.data_.get());  // 添加分隔符
-            result.append(strings[i].data_.get());  // 添加当前元素
-        }
-    }
-    return MString(result.c_str());  // 将 std::string 转换回 MString 类型
-}
-
 // 字符串修剪
 MString MString::trim() const {
-    const char* start = data_.get();
-    while (isspace(*start)) start++;
-
-    const char* end = data_.get() + strlen(data_.get()) - 1;
-    while (end > start && isspace(*end)) end--;
-
-    size_t trimLen = end - start + 1;
-    std::unique_ptr<char[]> trimStr(new char[trimLen + 1]);
-    strncpy_s(trimStr.get(), trimLen, start, trimLen);
-    trimStr[trimLen] = '\0';
-
-    MString trimmed(trimStr.get());
-    return trimmed;
+    return MString(view().trim());
 }
 
 // 查找子字符串并返回开始位置
-int MString::find(const char* substr, size_t startPos) const {
-    if (!substr) return false;
-
-    size_t patternLen = strlen(substr);
-    if (patternLen == 0 || startPos >= len_) {
-        return -1;  // 子串为空或起始位置无效
-    }
-
-    // 预处理坏字符规则
-    std::vector<int> badChar(256, -1); // 假设字符集是ASCII
-    for (size_t i = 0; i < patternLen; ++i) {
-        badChar[static_cast<unsigned char>(substr[i])] = i;
-    }
-
-    // 从 startPos 开始进行查找
-    size_t i = startPos;
-    while (i <= len_ - patternLen) {
-        size_t j = patternLen - 1;
-
-        // 从后向前匹配
-        while (j >= 0 && data_[i + j] == substr[j]) {
-            --j;
-        }
-
-        // 如果匹配成功
-        if (j == -1) {
-            return i;  // 返回匹配的起始位置
-        }
-
-        // 根据坏字符规则，计算跳跃距离
-        size_t badCharShift = j - badChar[static_cast<unsigned char>(data_[i + j])];
-        size_t shift = (badCharShift > 0) ? badCharShift : 1;
-
-        // 更新i的值，跳过不必要的字符
-        i += shift;
-    }
-
-    // 如果没有找到
-    return -1;
+int MString::find(MStringView substr, size_t startPos) const {
+    return view().find(substr, startPos);
 }
 
 // 反向查找子字符串并返回开始位置 (从尾部查找)
-int MString::rfind(const char* substr, size_t startPos) const {
-    if (!substr) return -1;
-
-    size_t patternLen = strlen(substr);
-    if (patternLen == 0 || startPos < 0) {
-        return -1;
-    }
-
-    // 默认从字符串末尾开始查找
-    if (startPos == std::string::npos || startPos >= len_) {
-        startPos = len_ - 1;
-    }
-
-    // 从startPos开始反向查找
-    for (size_t i = startPos; i >= patternLen - 1; --i) {
-        bool match = true;
-        for (size_t j = 0; j < patternLen; ++j) {
-            if (data_[i - j] != substr[patternLen - j - 1]) {
-                match = false;
-                break;
-            }
-        }
-        if (match) {
-            return i - patternLen + 1;
-        }
-    }
-
-    return -1;
+int MString::rfind(MStringView substr, size_t startPos) const {
+    return view().rfind(substr, startPos);
 }
 
 // 判断是否包含特定子字符串的函数
-bool MString::contains(const char* substr) const {
+bool MString::contains(MStringView substr) const {
     return find(substr) != -1;
 }
 
+// 忽略ASCII大小写查找子字符串并返回开始位置
+int MString::findIgnoreCase(MStringView substr, size_t startPos) const {
+    return view().findIgnoreCase(substr, startPos);
+}
+
 // 返回从指定位置开始的指定数量的字符
 MString MString::mid(size_t pos, size_t n) const {
-    if (pos > len_) {
-        return MString("");  // 超出字符串长度，返回空字符串
-    }
-    size_t numChars = (pos + n > len_) ? len_ - pos : n;
-    std::unique_ptr<char[]> sub(new char[numChars + 1]);
-    std::memcpy(sub.get(), data_.get() + pos, numChars);
-    sub[numChars] = '\0';
-    MString result(sub.get());
-    return result;
+    return MString(view().mid(pos, n));
 }
 
 // 返回字符串左侧的指定数量的字符
 MString MString::left(size_t n) const {
-    return mid(0, n);
+    return MString(view().left(n));
 }
 
 // 返回字符串右侧的指定数量的字符
 MString MString::right(size_t n) const {
-    size_t start = (n > len_) ? 0 : len_ - n;
-    return mid(start, n);
+    return MString(view().right(n));
+}
+
+// UTF-8码点数
+size_t MString::codePointLength() const {
+    return view().codePointLength();
+}
+
+// 按码点返回从第pos个码点开始的n个码点
+MString MString::codePointMid(size_t pos, size_t n) const {
+    return MString(view().codePointMid(pos, n));
+}
+
+// 按码点返回左侧的n个码点
+MString MString::codePointLeft(size_t n) const {
+    return MString(view().codePointLeft(n));
+}
+
+// 按码点返回右侧的n个码点
+MString MString::codePointRight(size_t n) const {
+    return MString(view().codePointRight(n));
+}
+
+// 按码点遍历
+MStringCodePoints MString::codePoints() const {
+    return view().codePoints();
 }
 
 // 转换为大写
 MString MString::toUpperCase() const {
-    std::unique_ptr<char[]> upper(new char[len_ + 1]);
-    for (size_t i = 0; i < len_; i++) {
-        upper[i] = std::toupper(data_[i]);
-    }
-    upper[len_] = '\0';
-    return MString(upper.get());
+    size_t len = length();
+    MString result;
+    MStringSimd::toUpper(result.initLength(len), getData(), len);
+    return result;
 }
 
 // 转换为小写
 MString MString::toLowerCase() const {
-    std::unique_ptr<char[]> lower(new char[len_ + 1]);
-    for (size_t i = 0; i < len_; i++) {
-        lower[i] = std::tolower(data_[i]);
-    }
-    lower[len_] = '\0';
-    return MString(lower.get());
+    size_t len = length();
+    MString result;
+    MStringSimd::toLower(result.initLength(len), getData(), len);
+    return result;
+}
+
+// 原地转换为大写
+MString& MString::makeUpperCase() {
+    MStringSimd::toUpper(mutableData(), getData(), length());
+    return *this;
+}
+
+// 原地转换为小写
+MString& MString::makeLowerCase() {
+    MStringSimd::toLower(mutableData(), getData(), length());
+    return *this;
 }
 
 // 判断是否为空
 bool MString::isEmpty() const {
-    return len_ == 0;
+    return length() == 0;
 }
 
 // 输出运算符重载
 std::ostream& operator<<(std::ostream& os, const MString& obj) {
-    os << obj.data_.get();
+    os.write(obj.getData(), obj.length());
     return os;
 }
 
 // 重载赋值运算符
 MString& MString::operator=(const char* str) {
-    if (data_.get() != str) {
-        len_ = strlen(str);
-        std::unique_ptr<char[]> temp = std::move(data_); // 将data的所有权转,超出范围自动释放
-        data_.reset(new char[len_ + 1]);
-        strcpy_s(data_.get(), len_, str);
+    if (getData() != str) {
+        assign(str, strlen(str));
     }
     return *this;
 }
 
+// 重载赋值运算符：拷贝视图内容
+MString& MString::operator=(MStringView view) {
+    assign(view.data(), view.length());
+    return *this;
+}
+
 // 是否为UTF-8编码：true->UTF-8;false->ANSI(GBK)
 bool MString::isUtf8Encoding(const char* str) {
-    int count = 0;
-    unsigned char single;
-    bool allAscii = true;
-    int len_ = strlen(str);
-
-    //0x00-0x7F为ASCII码范围
-    for (int uIndex = 0; uIndex < len_; ++uIndex) {
-        single = str[uIndex];
-
-        if ((single & 0x80) != 0)
-            allAscii = false;
-
-        if (count == 0) {
-            if (single >= 0x80) {
-                if (single >= 0xFC && single <= 0xFD)
-                    count = 6;
-                else if (single >= 0xF8)
-                    count = 5;
-                else if (single >= 0xF0)
-                    count = 4;
-                else if (single >= 0xE0)
-                    count = 3;
-                else if (single >= 0xC0)
-                    count = 2;
-                else
-                    return false;
-
-                count--;
-            }
-        } else {
-            if ((single & 0xC0) != 0x80)//在UTF-8中，以位模式10开始的所有字节是多字节序列的后续字节
-                return false;
-
-            count--;
-        }
-    }
-
-    if (count > 0)
-        return false;
-
-    if (allAscii)
-        return false;
+    return isUtf8Encoding(str, strlen(str));
+}
 
-    return true;
+// 是否为UTF-8编码：纯ASCII按ANSI处理，与getStringEncoding一致
+bool MString::isUtf8Encoding(const char* data, size_t len) {
+    size_t ascii = MStringSimd::asciiLength(data, len);
+    return ascii < len && MStringSimd::validateUtf8(data + ascii, len - ascii);
 }
 
 // 获取编码格式
 StringEncoding MString::getStringEncoding(const char* str) {
-    /*
-    ANSI                     无格式定义						对于中文编码格式是GB2312;
-    Unicode little endian    文本里前两个字节为FF FE			字节流是little endian
-    Unicode big endian       文本里前两个字节为FE FF			字节流是big endian
-    UTF-8带BOM               前两字节为EF BB，第三字节为BF		带BOM
-    UTF-8不带BOM             无格式定义,需另加判断				不带BOM
-    */
-
-    int size = strlen(str);
-    if (size == 0) {
-        return StringEncoding_Empty;
-    }
-    if (size == 1) {
-        return StringEncoding_ANSI;
-    }
-    StringEncoding se;
-    int nHead = ((unsigned char)str[0] << 8) + (unsigned char)str[1];
-
-    switch (nHead) {
-        case 0xFFFE:
-            se = StringEncoding_UTF16_LE;
-            break;
-        case 0xFEFF:
-            se = StringEncoding_UTF16_BE;
-            break;
-        case 0xEFBB:
-            se = StringEncoding_UTF8_BOM;
-            break;
-        default: {
-            if (isUtf8Encoding(str))
-                se = StringEncoding_UTF8;
-            else
-                se = StringEncoding_ANSI;
-            break;
-        }
-    }
-    return se;
+    return getStringEncoding(str, strlen(str));
+}
+
+// 获取编码格式
+StringEncoding MString::getStringEncoding(const char* data, size_t len) {
+    return MStringEncodingDetector::detect(data, len);
+}
+
+// 编码转换：按最大长度分配一次，转换后设置实际长度
+MStringConvertResult MString::convertEncoding(MStringView input, StringEncoding from, StringEncoding to, MString& output) {
+    MString result;
+    size_t maxLen = MStringConverter::maxOutputLength(from, to, input.length());
+    char* out = result.initLength(maxLen);
+    MStringConvertResult status = MStringConverter::convert(from, to, input.data(), input.length(), out, maxLen);
+    result.setLength(status.written);
+    output = std::move(result);// input可能引用output，转换完成后再替换
+    return status;
+}
+
+// GBK -> UTF-8
+MString MString::gbkToUtf8() const {
+    MString result;
+    convertEncoding(view(), StringEncoding_ANSI, StringEncoding_UTF8, result);
+    return result;
+}
+
+// UTF-8 -> GBK
+MString MString::utf8ToGbk() const {
+    MString result;
+    convertEncoding(view(), StringEncoding_UTF8, StringEncoding_ANSI, result);
+    return result;
 }
 
 // 获取编码，以16进制字符串表示
 MString MString::getHexString() const {
-    static const char* hexChars = "0123456789ABCDEF";
-    size_t hexLen = len_ * 3 - 1; // two hex digits per byte plus spaces
-    std::unique_ptr<char[]> hexData(new char[hexLen + 1]);
+    return toHex(" ");
+}
 
-    for (size_t i = 0, j = 0; i < len_; ++i) {
-        if (i != 0) {
-            hexData[j++] = ' ';
-        }
-        unsigned char byte = static_cast<unsigned char>(data_[i]);
-        hexData[j++] = hexChars[(byte >> 4) & 0x0F];
-        hexData[j++] = hexChars[byte & 0x0F];
-    }
-    hexData[hexLen] = '\0'; // null terminate the string
+// 十六进制编码：按编码后长度分配一次
+MString MString::toHex(MStringView separator, bool upperCase) const {
+    MString result;
+    char* out = result.initLength(MStringCodec::hexEncodedLength(length(), separator.length()));
+    MStringCodec::hexEncode(out, getData(), length(), separator, upperCase);
+    return result;
+}
 
-    return MString(hexData.get());
+// 十六进制解码：按最大长度分配一次，解码后设置实际长度
+MStringConvertResult MString::fromHex(MStringView hex, MString& output, MStringView separator) {
+    MString result;
+    size_t maxLen = MStringCodec::hexDecodedMaxLength(hex.length(), separator.length());
+    char* out = result.initLength(maxLen);
+    MStringConvertResult status = MStringCodec::hexDecode(hex.data(), hex.length(), out, maxLen, separator);
+    result.setLength(status.written);
+    output = std::move(result);// hex可能引用output，解码完成后再替换
+    return status;
+}
+
+// Base64编码：按编码后长度分配一次
+MString MString::toBase64() const {
+    MString result;
+    char* out = result.initLength(MStringCodec::base64EncodedLength(length()));
+    MStringCodec::base64Encode(out, getData(), length());
+    return result;
+}
+
+// Base64解码：按最大长度分配一次，解码后设置实际长度
+MStringConvertResult MString::fromBase64(MStringView text, MString& output) {
+    MString result;
+    size_t maxLen = MStringCodec::base64DecodedMaxLength(text.length());
+    char* out = result.initLength(maxLen);
+    MStringConvertResult status = MStringCodec::base64Decode(text.data(), text.length(), out, maxLen);
+    result.setLength(status.written);
+    output = std::move(result);// text可能引用output，解码完成后再替换
+    return status;
 }
 
 // 获取当前时间
@@ -457,11 +553,11 @@ MString MString::getCurrentTime() {
 // 重载 == 运算符
 bool MString::operator==(const MString& other) const {
     // 首先比较长度
-    if (this->len_ != other.len_) {
+    if (this->length() != other.length()) {
         return false;
     }
-    // 然后逐字符比较
-    return strcmp(this->data_.get(), other.data_.get()) == 0;
+    // 然后逐字节比较（可能包含'\0'，与哈希一致按完整长度比较）
+    return memcmp(this->getData(), other.getData(), this->length()) == 0;
 }
 
 // 重载 != 运算符
@@ -476,23 +572,6 @@ bool MString::isNumber(const MString& s) {
 
 // 判断是否为数字
 bool MString::isNumber(const char* s) {
-    std::string newValue(s);
-    std::istringstream iss(newValue);
-    double doubleValue;
-
-    // 尝试从字符串中提取浮点数
-    if (iss >> doubleValue) {
-        // 检查提取后是否到达字符串末尾
-        char c;
-        if (iss >> c) {
-            // 如果提取后仍有字符，则说明不是有效的浮点数格式
-            return false;
-        } else {
-            // 提取成功且到达字符串末尾，说明是有效的浮点数格式
-            return true;
-        }
-    } else {
-        // 提取失败，说明不是有效的浮点数格式
-        return false;
-    }
+    double value = 0;
+    return MStringNumber::parse(MStringView(s), value) == MStringNumberError::NUMBER_OK;
 }
\ No newline at end of file
@@ -3,31 +3,112 @@
 
 #include <cstring>
 #include <vector>
+#include <utility>
 #include <iterator>
 #include <sstream>
 #include <memory>
+#include <type_traits>
+#include "MStringView.h"
+#include "MStringConcat.h"
+#include "MStringNumber.h"
+#include "MStringEncoding.h"
+#include "MStringAllocator.h"
 
-enum StringEncoding {
-    StringEncoding_Empty = -2,
-    StringEncoding_Unknown = -1,
-    StringEncoding_ANSI = 0,
-    StringEncoding_UTF8,
-    StringEncoding_UTF8_BOM,
-    StringEncoding_UTF16_LE,
-    StringEncoding_UTF16_BE,
-};
+// 小字符串优化的存储布局依赖小端字节序
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "MString requires a little-endian target"
+#endif
+
+class MStringBatch;
 
 class MString {
 private:
-    std::unique_ptr<char[]> data_;// 数据缓冲区
-    size_t len_;// 数据长度
+    // 堆存储：长度超过内联容量时使用
+    struct HeapRep {
+        char* data;// 数据缓冲区
+        size_t len;// 数据长度
+        size_t cap;// 缓冲区容量（不含结尾'\0'），最高几位为存储标志
+    };
+
+    // 小字符串优化：短字符串直接存放在对象内部，不分配堆内存
+    // 内联存储时最后一个字节保存剩余容量(SMALL_CAPACITY - 长度)，长度达到上限时恰好作为结尾'\0'
+    // 堆存储时最后一个字节为cap的最高字节（小端），其最高位即堆存储标志
+    union {
+        HeapRep heap_;// 堆存储
+        char small_[sizeof(HeapRep)];// 内联存储
+    };
+
+    static const size_t SMALL_CAPACITY = sizeof(HeapRep) - 1;// 内联存储最大长度：64位下23字节
+    static const size_t HEAP_FLAG = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);// 堆存储标志
+    static const size_t ALLOCATOR_FLAG = HEAP_FLAG >> 1;// 缓冲区来自自定义分配器，数据之前保存分配器指针
+    static const size_t MONOTONIC_FLAG = HEAP_FLAG >> 2;// 分配器的释放为空操作，释放时不访问缓冲区
+    static const size_t FLAG_MASK = HEAP_FLAG | ALLOCATOR_FLAG | MONOTONIC_FLAG;
+    static const size_t ALLOCATOR_HEADER = sizeof(MStringAllocator*);// 自定义分配器缓冲区的头部大小
+
+    // 是否为内联存储
+    bool isSmall() const {
+        return (static_cast<unsigned char>(small_[SMALL_CAPACITY]) & 0x80) == 0;
+    }
+
+    // 可写数据指针
+    char* mutableData() {
+        return isSmall() ? small_ : heap_.data;
+    }
+
+    // 初始化为空字符串（不释放原有资源）
+    void initEmpty() {
+        small_[0] = '\0';
+        small_[SMALL_CAPACITY] = static_cast<char>(SMALL_CAPACITY);
+    }
+
+    // 初始化为长度为len的未填充字符串（不释放原有资源），返回可写数据指针
+    char* initLength(size_t len);
+
+    // 设置长度并写入结尾'\0'，len不能超过容量
+    void setLength(size_t len);
+
+    // 释放堆存储
+    void release();
+
+    // 替换为指定内容，容量足够时复用原缓冲区
+    void assign(const char* s, size_t len);
+
+    // 接管allocator分配的堆缓冲区（不释放原有资源）
+    void setHeap(char* data, size_t len, size_t capacity, MStringAllocator* allocator);
+
+    // 追加时的扩容策略：至少翻倍，摊还O(1)
+    size_t growCapacity(size_t minCapacity) const;
+
+    // 分配/释放堆缓冲区，capacity不含结尾'\0'；allocator为nullptr时使用默认堆
+    static char* allocate(size_t capacity, MStringAllocator* allocator);
+    static void deallocate(char* data, size_t capacity, MStringAllocator* allocator);
+
+    friend class MStringBuilder;
+    friend class MStringFormat;
 public:
     // 构造函数
     MString(const char* s = "") noexcept;
 
+    // 构造函数：指定长度，s中可包含'\0'
+    MString(const char* s, size_t len) noexcept;
+
+    // 构造函数：拷贝视图内容
+    MString(MStringView view) noexcept;
+
+    // 构造函数：使用指定分配器，始终使用堆存储以便扩容时沿用该分配器
+    // 拷贝得到的字符串使用默认堆，移动时分配器随缓冲区一起转移
+    MString(MStringView view, MStringAllocator* allocator);
+
+    // 构造函数：拼接表达式，一次性计算长度并分配内存
+    template<typename L, typename R>
+    MString(const MStringConcat<L, R>& expr) noexcept {
+        expr.writeTo(initLength(expr.length()));
+    }
+
     // 构造函数
     template<class T>
     MString(const T& value) noexcept {
+        initEmpty();
         *this = value;
     }
 
@@ -47,7 +128,19 @@ public:
     ~MString();
 
     // 添加 c_str() 方法
-    const char* getData() const;
+    const char* getData() const {
+        return isSmall() ? small_ : heap_.data;
+    }
+
+    // MString -> MStringView（视图在MString修改或析构后失效）
+    MStringView view() const {
+        return MStringView(getData(), length());
+    }
+
+    // 隐式转换为视图，便于将 MString 传给接受 MStringView 的接口
+    operator MStringView() const {
+        return view();
+    }
 
     // std::string -> MString
     static MString fromStdString(const std::string& str);
@@ -55,46 +148,183 @@ public:
     // MString -> std::string
     std::string toStdString() const;
 
-    // 字符串连接
-    MString operator+(const MString& other) const;
-
     // 重载+=
     MString& operator+=(const char* str);
 
+    // 重载+=
+    MString& operator+=(const MString& other) {
+        return append(other.getData(), other.length());
+    }
+
+    // 重载+=
+    MString& operator+=(const std::string& str) {
+        return append(str.data(), str.size());
+    }
+
+    // 重载+=，支持视图
+    MString& operator+=(MStringView view);
+
+    // 重载+=
+    MString& operator+=(char c);
+
+    // 重载+=：追加拼接表达式
+    template<typename L, typename R>
+    MString& operator+=(const MStringConcat<L, R>& expr) {
+        return append(expr);
+    }
+
+    // 预留容量，避免多次追加时重复分配
+    void reserve(size_t capacity);
+
+    // 追加指定长度的数据，容量不足时按几何增长扩容
+    MString& append(const char* s, size_t len);
+
+    // 追加字符串
+    MString& append(const MString& other) {
+        return append(other.getData(), other.length());
+    }
+
+    // 追加字符串
+    MString& append(const char* str) {
+        return append(str, strlen(str));
+    }
+
+    // 追加字符串
+    MString& append(const std::string& str) {
+        return append(str.data(), str.size());
+    }
+
+    // 追加视图
+    MString& append(MStringView view) {
+        return append(view.data(), view.length());
+    }
+
+    // 追加单个字符
+    MString& append(char c);
+
+    // 追加拼接表达式
+    template<typename L, typename R>
+    MString& append(const MStringConcat<L, R>& expr) {
+        size_t oldLen = length();
+        size_t len = expr.length();
+        if (len > capacity() - oldLen) {
+            // 先写入新缓冲区再释放旧缓冲区，表达式引用自身时依然有效
+            size_t newCapacity = growCapacity(oldLen + len);
+            MStringAllocator* alloc = allocator();
+            char* data = allocate(newCapacity, alloc);
+            std::memcpy(data, getData(), oldLen);
+            expr.writeTo(data + oldLen);
+            release();
+            setHeap(data, oldLen + len, newCapacity, alloc);
+            return *this;
+        }
+        expr.writeTo(mutableData() + oldLen);
+        setLength(oldLen + len);
+        return *this;
+    }
+
+    // 追加整数（十进制）
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value,
+        MString&>::type append(T value) {
+        char buffer[MStringNumber::MAX_LENGTH];
+        return append(buffer, MStringNumber::toChars(buffer, value));
+    }
+
+    // 追加浮点数（能精确还原的最短表示）
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, MString&>::type append(T value) {
+        char buffer[MStringNumber::MAX_LENGTH];
+        return append(buffer, MStringNumber::toChars(buffer, value));
+    }
+
     // 获取长度
-    size_t length() const;
+    size_t length() const {
+        return isSmall() ? SMALL_CAPACITY - static_cast<unsigned char>(small_[SMALL_CAPACITY]) : heap_.len;
+    }
+
+    // 获取容量（不分配堆内存可容纳的最大长度）
+    size_t capacity() const {
+        return isSmall() ? SMALL_CAPACITY : (heap_.cap & ~FLAG_MASK);
+    }
+
+    // 缓冲区所属的分配器，内联存储或默认堆返回nullptr
+    MStringAllocator* allocator() const;
 
     // 字符串比较
-    int compareTo(const MString& other) const;
+    int compareTo(MStringView other) const;
+
+    // 忽略ASCII大小写比较
+    int compareIgnoreCase(MStringView other) const;
+
+    // 忽略ASCII大小写判断是否相等
+    bool equalsIgnoreCase(MStringView other) const;
 
     // 字符串查找
-    int indexOf(const char* substr) const;
+    int indexOf(MStringView substr) const;
 
     // 字符串反向查找
-    int lastIndexOf(const char* substr) const;
+    int lastIndexOf(MStringView substr) const;
 
-    // 字符串替换
-    MString replace(const char* find, const char* replace) const;
+    // 字符串替换：替换所有不重叠的find，结果只分配一次内存
+    MString replace(MStringView find, MStringView replace) const;
 
-    // 字符串分割
-    std::vector<MString> split(const char* delimiter) const;
+    // 批量替换：一次扫描完成所有 find->replace，同一位置优先替换最靠左、最长的find，find相同时靠前的一项生效
+    // 需要在大量字符串上重复使用同一组替换时，直接使用 MStringMatcher::replaceAll 避免重复构建
+    MString replace(const std::vector<std::pair<MStringView, MStringView>>& replacements) const;
 
-    // 字符串拼接
-    static MString join(const std::vector<MString>& strings, const MString& separator);
+    // 字符串分割：delimiter中的任一字符均为分隔符，忽略空字段（与strtok一致）
+    // 不分配内存的版本：view().splitBy() / view().splitAnyOf()
+    std::vector<MString> split(MStringView delimiter) const;
 
+    // 字符串拼接：元素可以是 MString、std::string、const char*、视图或拼接表达式，只分配一次内存
+    template<typename T>
+    static MString join(const std::vector<T>& strings, MStringView separator) {
+        return joinImpl(strings, separator);
+    }
+
+    // 字符串拼接：分隔符为拼接表达式
+    template<typename T, typename L, typename R>
+    static MString join(const std::vector<T>& strings, const MStringConcat<L, R>& separator) {
+        return joinImpl(strings, separator);
+    }
+private:
+    // 字符串拼接实现：先计算总长度，再逐段写入
+    template<typename T, typename S>
+    static MString joinImpl(const std::vector<T>& strings, const S& separator) {
+        MString result;
+        if (strings.empty()) {
+            return result;
+        }
+        size_t total = concatLength(separator) * (strings.size() - 1);
+        for (const auto& str : strings) {
+            total += concatLength(str);
+        }
+        char* out = result.initLength(total);
+        out = concatWrite(out, strings[0]);  // 添加第一个元素
+        for (size_t i = 1; i < strings.size(); i++) {
+            out = concatWrite(out, separator);  // 添加分隔符
+            out = concatWrite(out, strings[i]);  // 添加当前元素
+        }
+        return result;
+    }
+public:
     // 字符串修剪
     MString trim() const;
 
     // 查找子字符串并返回开始位置
-    int find(const char* substr, size_t startPos = 0) const;
+    int find(MStringView substr, size_t startPos = 0) const;
 
     // 反向查找子字符串并返回开始位置 (从尾部查找)
-    int rfind(const char* substr, size_t startPos = std::string::npos) const;
+    int rfind(MStringView substr, size_t startPos = std::string::npos) const;
 
     // 判断是否存在字串
-    bool contains(const char* substr) const;
+    bool contains(MStringView substr) const;
+
+    // 忽略ASCII大小写查找子字符串并返回开始位置
+    int findIgnoreCase(MStringView substr, size_t startPos = 0) const;
 
-    // 返回从指定位置开始的指定数量的字符
+    // 返回从指定位置开始的指定数量的字符（不分配内存的版本：view().mid()，left/right/trim/split同理）
     MString mid(size_t pos, size_t n) const;
 
     // 返回字符串左侧的指定数量的字符
@@ -103,75 +333,108 @@ public:
     // 返回字符串右侧的指定数量的字符
     MString right(size_t n) const;
 
-    // 转换为大写
+    // UTF-8码点数（length()为字节数）
+    // 码点计数与codePoint*截取按非后续字节（非10xxxxxx）划分码点，只对合法的UTF-8有定义；
+    // 非法序列下与codePoints()遍历（每个非法字节一个U+FFFD）的结果不一致，输入不可信时先校验编码
+    size_t codePointLength() const;
+
+    // 按码点返回从第pos个码点开始的n个码点，不会截断多字节字符
+    MString codePointMid(size_t pos, size_t n) const;
+
+    // 按码点返回左侧的n个码点
+    MString codePointLeft(size_t n) const;
+
+    // 按码点返回右侧的n个码点
+    MString codePointRight(size_t n) const;
+
+    // 按码点遍历：for (uint32_t cp : str.codePoints())
+    MStringCodePoints codePoints() const;
+
+    // 转换为大写（仅ASCII字母，其他字节保持不变）
     MString toUpperCase() const;
 
-    // 转换为小写
+    // 转换为小写（仅ASCII字母，其他字节保持不变）
     MString toLowerCase() const;
 
+    // 原地转换为大写
+    MString& makeUpperCase();
+
+    // 原地转换为小写
+    MString& makeLowerCase();
+
     // 判断是否为空
     bool isEmpty() const;
 
     // 输出运算符重载
     friend std::ostream& operator<<(std::ostream & os, const MString & obj);
 
-    // 格式化字符串并返回 MString
+    // 格式化字符串并返回 MString："{}"依次替换为参数，支持"{:格式}"（见 MStringFormat::formatTo），"{{"/"}}"输出花括号
+    // 与早期基于std::ostream的实现不同：浮点数默认输出能还原原值的最短表示（1.0/3 -> 0.3333333333333333），
+    // 需要原来的6位有效数字时写"{:g}"；"{{"/"}}"原先原样输出，现在输出单个花括号
     template <typename... Args>
-    static MString format(const std::string& format, Args&&... args) {
-        // 估算需要的空间，提前分配
-        size_t estimated_size = format.size() + (sizeof...(args) * 32);  // 大致预估每个参数占32字符空间
-        std::vector<char> buffer;
-        buffer.reserve(estimated_size);
+    static MString format(MStringView fmt, const Args&... args);
 
-        // 开始格式化过程
-        formatImpl(buffer, format, std::forward<Args>(args)...);
+    // 追加格式化结果，复用已有容量
+    template <typename... Args>
+    MString& appendFormat(MStringView fmt, const Args&... args);
 
-        // 使用构造函数创建 MString 对象
-        return MString(std::string(buffer.begin(), buffer.end()));
-    }
-private:
-    // 基本类型支持（对所有类型支持输出到流）
-    template <typename T>
-    static void appendToBuffer(std::vector<char>& buffer, const T& value) {
-        std::ostringstream oss;
-        oss << value;
-        std::string str = oss.str();
-        buffer.insert(buffer.end(), str.begin(), str.end());
-    }
-
-    // 递归函数，将格式字符串与参数进行匹配并输出到缓冲区
-    static void formatImpl(std::vector<char>& buffer, const std::string& format) {
-        buffer.insert(buffer.end(), format.begin(), format.end());
-    }
-
-    // 主递归实现，处理每个参数并替换{}
-    template <typename T, typename... Args>
-    static void formatImpl(std::vector<char>& buffer, const std::string& format, T&& value, Args&&... args) {
-        size_t pos = format.find("{}");  // 查找第一个 {}
-        if (pos != std::string::npos) {
-            // 插入 '{}' 前的部分
-            buffer.insert(buffer.end(), format.begin(), format.begin() + pos);
-
-            // 插入当前参数
-            appendToBuffer(buffer, std::forward<T>(value));
-
-            // 递归处理剩余部分
-            formatImpl(buffer, format.substr(pos + 2), std::forward<Args>(args)...);
-        } else {
-            // 没有更多的 {}，直接插入剩余的格式字符串
-            formatImpl(buffer, format);
-        }
+    // 清空内容，保留容量以便复用
+    void clear() {
+        setLength(0);
     }
 public:// 编码相关
     // 是否为UTF-8编码：true->UTF-8;false->ANSI(GBK)
     static bool isUtf8Encoding(const char* str);
 
+    // 是否为UTF-8编码：严格校验且至少含一个非ASCII字节，不要求以'\0'结尾
+    static bool isUtf8Encoding(const char* data, size_t len);
+
     // 获取编码格式
     static StringEncoding getStringEncoding(const char* str);
 
-    // 获取编码，以16进制字符串表示
+    // 获取编码格式：不要求以'\0'结尾，可用于UTF-16数据；分块数据使用 MStringEncodingDetector
+    static StringEncoding getStringEncoding(const char* data, size_t len);
+
+    // 编码转换：结果写入output，出错时output为出错位置之前的部分；分块数据使用 MStringConverter
+    static MStringConvertResult convertEncoding(MStringView input, StringEncoding from, StringEncoding to, MString& output);
+
+    // GBK -> UTF-8，遇到非法序列时返回此前已转换的部分
+    MString gbkToUtf8() const;
+
+    // UTF-8 -> GBK，遇到非法序列或GBK无法表示的字符时返回此前已转换的部分
+    MString utf8ToGbk() const;
+
+    // 获取编码，以16进制字符串表示（字节之间以空格分隔）
     MString getHexString() const;
 
+    // 十六进制编码：separator插入在字节之间
+    MString toHex(MStringView separator = MStringView(), bool upperCase = true) const;
+
+    // 十六进制解码：结果写入output，出错时output为出错位置之前的部分
+    static MStringConvertResult fromHex(MStringView hex, MString& output, MStringView separator = MStringView());
+
+    // Base64编码（标准字母表，以'='填充）
+    MString toBase64() const;
+
+    // Base64解码：严格校验字母表和填充，出错时output为出错位置之前的部分
+    static MStringConvertResult fromBase64(MStringView text, MString& output);
+
+    // 批量排序（按无符号字节序，与compareTo一致）：MSD基数排序，排序键缓存8字节前缀，不逐个调用compareTo
+    static void sort(std::vector<MString>& strings);
+
+    // 多线程排序：按采样得到的分割点将数据划分给各线程后分别基数排序，数据量较小时直接调用sort
+    // threadCount为0时使用硬件线程数
+    static void parallelSort(std::vector<MString>& strings, unsigned threadCount = 0);
+
+    // 去除已排序序列中相邻的重复项
+    static void uniqueSorted(std::vector<MString>& sorted);
+
+    // 多路归并已排序的序列
+    static std::vector<MString> mergeSorted(const std::vector<std::vector<MString>>& inputs);
+
+    // 批量操作：MString::batch::toLowerCase(strings)等，结果连续存放，数据量较大时由工作线程池并行处理
+    typedef MStringBatch batch;
+
     // 获取当前时间
     static MString getCurrentTime();
 public:// 基础类型与MString之间转换
@@ -187,41 +450,98 @@ public:// 基础类型与MString之间转换
     // 判断是否为数字
     static bool isNumber(const char* s);
 
-    // 字符串转数值
+    // 字符串转数值：整数类型按整数精确解析（整数格式无效时按浮点数解析后截断），无效或超出范围时返回0
     template<typename T>
     static T convert(const char* value) {
-        try {
-            return std::stod(std::string(value));
-        } catch (const std::invalid_argument& e) {
-            return static_cast<T>(0.0);
-        } catch (const std::out_of_range& e) {
-            return static_cast<T>(0.0);
-        }
+        return parseNumber<T>(MStringView(value));
     }
 
     // 数值 -> MString
     template<typename T>
     static MString convert(const T& value) {
-        std::stringstream ss;
-        ss << value;
-        return fromStdString((std::string)ss.str());
+        return convertValue(value, IsNumber<T>());
     }
 
     // 类型转换运算符/转换构造函数: int x = str; 隐式调用int x = operator int();
-    template<typename T>
+    template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
     operator T()const {
-        return convert<T>(data_.get());
+        return parseNumber<T>(view());
     }
 
-    // 重载赋值运算符
+    // 重载赋值运算符：数值直接格式化到内部存储，其他类型通过operator<<输出
+    template<typename T>
+    MString& operator=(const T& value) {
+        return assignValue(value, IsNumber<T>());
+    }
+private:
+    // 按数值格式化的类型（char按字符处理）
+    template<typename T>
+    struct IsNumber : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, char>::value> {};
+
+    // 字符串 -> 整数
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value, T>::type parseNumber(MStringView text) {
+        T value = 0;
+        MStringNumberError error = MStringNumber::parse(text, value);
+        if (error == MStringNumberError::NUMBER_INVALID) {
+            double number = 0;
+            if (MStringNumber::parse(text, number) == MStringNumberError::NUMBER_OK &&
+                number >= static_cast<double>(std::numeric_limits<T>::min()) &&
+                number <= static_cast<double>(std::numeric_limits<T>::max())) {
+                return static_cast<T>(number);
+            }
+        }
+        return error == MStringNumberError::NUMBER_OK ? value : static_cast<T>(0);
+    }
+
+    // 字符串 -> 浮点数
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, T>::type parseNumber(MStringView text) {
+        T value = 0;
+        return MStringNumber::parse(text, value) == MStringNumberError::NUMBER_OK ? value : static_cast<T>(0);
+    }
+
+    // 数值 -> MString
+    template<typename T>
+    static MString convertValue(const T& value, std::true_type) {
+        char buffer[MStringNumber::MAX_LENGTH];
+        return MString(buffer, MStringNumber::toChars(buffer, value));
+    }
+
+    // 其他类型 -> MString
     template<typename T>
-    MString& operator=(const T& num) {
-        *this = convert<T>(num);
+    static MString convertValue(const T& value, std::false_type) {
+        std::stringstream ss;
+        ss << value;
+        return fromStdString(ss.str());
+    }
+
+    // 赋值为数值
+    template<typename T>
+    MString& assignValue(const T& value, std::true_type) {
+        char buffer[MStringNumber::MAX_LENGTH];
+        assign(buffer, MStringNumber::toChars(buffer, value));
         return *this;
     }
 
+    // 赋值为其他类型
+    template<typename T>
+    MString& assignValue(const T& value, std::false_type) {
+        return *this = convertValue(value, std::false_type());
+    }
+public:
     // 重载赋值运算符
     MString& operator=(const char* str);
+
+    // 重载赋值运算符：拷贝视图内容
+    MString& operator=(MStringView view);
+
+    // 重载赋值运算符：拼接表达式（表达式可能引用自身，先生成再移动）
+    template<typename L, typename R>
+    MString& operator=(const MStringConcat<L, R>& expr) {
+        MString temp(expr);
+        return *this = std::move(temp);
+    }
 public:// 迭代器
     class Iterator {
     public:
@@ -271,12 +591,19 @@ public:// 迭代器
     };
 
     Iterator begin() {
-        return Iterator(data_.get());
+        return Iterator(mutableData());
     }
 
     Iterator end() {
-        return Iterator(data_.get() + len_);
+        return Iterator(mutableData() + length());
     }
 };
 
-#endif
\ No newline at end of file
+// 格式化实现依赖完整的MString定义，放在类定义之后引入
+#include "MStringFormat.h"
+// std::hash<MString>等哈希支持同样依赖完整的MString定义
+#include "MStringHash.h"
+// 批量操作返回连续存放的结果，同样依赖完整的MString定义
+#include "MStringBatch.h"
+
+#endif
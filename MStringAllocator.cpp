@@ -0,0 +1,137 @@
+#include "MStringAllocator.h"
+#include <new>
+
+// 分配的对齐粒度：缓冲区开头保存分配器指针
+static const size_t ALIGNMENT = sizeof(void*);
+
+static size_t alignUp(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+MStringArena::MStringArena(size_t blockSize)
+    : blocks_(nullptr), pos_(nullptr), end_(nullptr), blockSize_(blockSize), allocated_(0) {
+}
+
+MStringArena::~MStringArena() {
+    while (blocks_ != nullptr) {
+        Block* next = blocks_->next;
+        ::operator delete(blocks_);
+        blocks_ = next;
+    }
+}
+
+// 分配新内存块并设为当前块
+void MStringArena::addBlock(size_t size) {
+    Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+    block->next = blocks_;
+    block->size = size;
+    blocks_ = block;
+    pos_ = reinterpret_cast<char*>(block + 1);
+    end_ = pos_ + size;
+}
+
+// 顺序分配：当前块不足时分配新块，超过块大小一半的请求单独分配
+void* MStringArena::allocate(size_t size) {
+    size = alignUp(size);
+    if (size > static_cast<size_t>(end_ - pos_)) {
+        if (size > blockSize_ / 2) {
+            // 单独的大块插在当前块之后，当前块剩余空间继续使用
+            Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+            block->size = size;
+            if (blocks_ != nullptr) {
+                block->next = blocks_->next;
+                blocks_->next = block;
+            } else {
+                block->next = nullptr;
+                blocks_ = block;
+            }
+            allocated_ += size;
+            return block + 1;
+        }
+        addBlock(blockSize_);
+    }
+    void* ptr = pos_;
+    pos_ += size;
+    allocated_ += size;
+    return ptr;
+}
+
+// 整体回收
+void MStringArena::reset() {
+    Block* keep = nullptr;
+    while (blocks_ != nullptr) {
+        Block* next = blocks_->next;
+        if (keep == nullptr && blocks_->size == blockSize_) {
+            keep = blocks_;
+            keep->next = nullptr;
+        } else {
+            ::operator delete(blocks_);
+        }
+        blocks_ = next;
+    }
+    blocks_ = keep;
+    pos_ = keep != nullptr ? reinterpret_cast<char*>(keep + 1) : nullptr;
+    end_ = keep != nullptr ? pos_ + keep->size : nullptr;
+    allocated_ = 0;
+}
+
+const size_t MStringPool::MIN_SIZE;
+const size_t MStringPool::CLASS_COUNT;
+
+MStringPool::MStringPool(size_t chunkSize) : pos_(nullptr), end_(nullptr), chunkSize_(chunkSize) {
+    for (size_t i = 0; i < CLASS_COUNT; ++i) {
+        free_[i] = nullptr;
+    }
+}
+
+MStringPool::~MStringPool() {
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+        ::operator delete(chunks_[i]);
+    }
+}
+
+// size所在级别，超过最大级别返回CLASS_COUNT
+size_t MStringPool::sizeClass(size_t size) {
+    size_t index = 0;
+    for (size_t classSize = MIN_SIZE; classSize < size; classSize <<= 1) {
+        if (++index == CLASS_COUNT) {
+            break;
+        }
+    }
+    return index;
+}
+
+// 优先从同级空闲链表取，否则从当前大块切分
+void* MStringPool::allocate(size_t size) {
+    size_t index = sizeClass(size);
+    if (index == CLASS_COUNT) {
+        return ::operator new(size);
+    }
+    FreeNode* node = free_[index];
+    if (node != nullptr) {
+        free_[index] = node->next;
+        return node;
+    }
+    size_t classSize = MIN_SIZE << index;
+    if (classSize > static_cast<size_t>(end_ - pos_)) {
+        size_t chunkSize = chunkSize_ > classSize ? chunkSize_ : classSize;
+        chunks_.push_back(static_cast<char*>(::operator new(chunkSize)));
+        pos_ = chunks_.back();
+        end_ = pos_ + chunkSize;
+    }
+    void* ptr = pos_;
+    pos_ += classSize;
+    return ptr;
+}
+
+// 挂入同级空闲链表
+void MStringPool::deallocate(void* ptr, size_t size) {
+    size_t index = sizeClass(size);
+    if (index == CLASS_COUNT) {
+        ::operator delete(ptr);
+        return;
+    }
+    FreeNode* node = static_cast<FreeNode*>(ptr);
+    node->next = free_[index];
+    free_[index] = node;
+}
@@ -0,0 +1,98 @@
+#ifndef MSTRINGALLOCATOR_H
+#define MSTRINGALLOCATOR_H
+
+#include <cstddef>
+#include <vector>
+
+// 字符串缓冲区分配器：MString通过构造参数指定，扩容时沿用同一分配器
+class MStringAllocator {
+public:
+    virtual ~MStringAllocator() {}
+
+    // 分配size字节，按指针大小对齐
+    virtual void* allocate(size_t size) = 0;
+
+    // 释放allocate返回的内存，size与分配时一致
+    virtual void deallocate(void* ptr, size_t size) = 0;
+
+    // 释放是否为空操作：为true时字符串析构不访问缓冲区，分配器可以先于字符串整体回收
+    virtual bool isMonotonic() const {
+        return false;
+    }
+};
+
+// 单调分配器：从内存块中顺序分配，单个释放为空操作，reset时整体回收
+// 适用于单次请求内的临时字符串；reset后仍引用其内存的字符串只能析构，不能再访问。非线程安全
+class MStringArena : public MStringAllocator {
+public:
+    explicit MStringArena(size_t blockSize = 64 * 1024);
+    ~MStringArena();
+
+    void* allocate(size_t size) override;
+
+    void deallocate(void*, size_t) override {
+    }
+
+    bool isMonotonic() const override {
+        return true;
+    }
+
+    // 整体回收：保留一个标准大小的内存块供后续复用，其余归还给堆
+    void reset();
+
+    // 已分配的字节数（自上次reset起）
+    size_t allocatedBytes() const {
+        return allocated_;
+    }
+private:
+    // 内存块头部，数据紧随其后
+    struct Block {
+        Block* next;
+        size_t size;// 数据区大小
+    };
+
+    Block* blocks_;// 内存块链表，最新的在前
+    char* pos_;// 当前块的下一个可分配位置
+    char* end_;// 当前块的数据区末尾
+    size_t blockSize_;
+    size_t allocated_;
+
+    // 分配新内存块并设为当前块
+    void addBlock(size_t size);
+
+    MStringArena(const MStringArena&);
+    MStringArena& operator=(const MStringArena&);
+};
+
+// 分级内存池：按2的幂分级，释放的内存挂入同级空闲链表供复用，超过最大级别的直接使用堆
+// 适用于长期存在、频繁创建和销毁的字符串；析构时回收全部内存。非线程安全
+class MStringPool : public MStringAllocator {
+public:
+    static const size_t MIN_SIZE = 32;// 最小级别
+    static const size_t CLASS_COUNT = 12;// 级别数：32B ~ 64KB
+
+    explicit MStringPool(size_t chunkSize = 64 * 1024);
+    ~MStringPool();
+
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr, size_t size) override;
+private:
+    // 空闲链表节点，存放在已释放的内存中
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    FreeNode* free_[CLASS_COUNT];// 各级空闲链表
+    std::vector<char*> chunks_;// 从堆分配的大块内存
+    char* pos_;// 当前大块的下一个可分配位置
+    char* end_;
+    size_t chunkSize_;
+
+    // size所在级别，超过最大级别返回CLASS_COUNT
+    static size_t sizeClass(size_t size);
+
+    MStringPool(const MStringPool&);
+    MStringPool& operator=(const MStringPool&);
+};
+
+#endif //MSTRINGALLOCATOR_H
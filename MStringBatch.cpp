@@ -0,0 +1,268 @@
+#include "MStringBatch.h"
+#include "MStringSearcher.h"
+#include "MStringSimd.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// 工作线程池：线程常驻，调用方线程也参与执行，同一时间只处理一批任务
+class MStringWorkerPool {
+public:
+    static MStringWorkerPool& instance() {
+        static MStringWorkerPool pool(std::thread::hardware_concurrency());
+        return pool;
+    }
+
+    // 参与执行的线程数（含调用方线程）
+    unsigned threadCount() const {
+        return static_cast<unsigned>(threads_.size()) + 1;
+    }
+
+    // 执行task(0) ~ task(taskCount - 1)，全部完成后返回
+    void run(size_t taskCount, const std::function<void(size_t)>& task) {
+        std::lock_guard<std::mutex> runLock(runMutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_ = &task;
+        taskCount_ = taskCount;
+        next_ = 0;
+        finished_ = 0;
+        wake_.notify_all();
+        work(lock);
+        done_.wait(lock, [this]() {
+            return finished_ == taskCount_;
+        });
+        task_ = nullptr;
+        taskCount_ = 0;
+    }
+
+    ~MStringWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+private:
+    std::vector<std::thread> threads_;
+    std::mutex runMutex_;// 串行化并发的run调用
+    std::mutex mutex_;
+    std::condition_variable wake_;// 有新任务或停止
+    std::condition_variable done_;// 任务全部完成
+    const std::function<void(size_t)>* task_;
+    size_t taskCount_;
+    size_t next_;// 下一个待领取的任务
+    size_t finished_;// 已完成的任务数
+    bool stop_;
+
+    explicit MStringWorkerPool(unsigned hardwareThreads)
+        : task_(nullptr), taskCount_(0), next_(0), finished_(0), stop_(false) {
+        for (unsigned i = 1; i < hardwareThreads; ++i) {
+            threads_.emplace_back(&MStringWorkerPool::loop, this);
+        }
+    }
+
+    MStringWorkerPool(const MStringWorkerPool&);
+    MStringWorkerPool& operator=(const MStringWorkerPool&);
+
+    // 领取并执行任务，直到没有剩余任务（调用时持有锁）
+    void work(std::unique_lock<std::mutex>& lock) {
+        while (next_ < taskCount_) {
+            size_t index = next_++;
+            const std::function<void(size_t)>& task = *task_;
+            lock.unlock();
+            task(index);
+            lock.lock();
+            if (++finished_ == taskCount_) {
+                done_.notify_all();
+            }
+        }
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this]() {
+                return stop_ || next_ < taskCount_;
+            });
+            if (stop_) {
+                return;
+            }
+            work(lock);
+        }
+    }
+};
+
+// 并行阈值
+static std::atomic<size_t> g_parallelThreshold(MStringBatch::DEFAULT_PARALLEL_THRESHOLD);
+
+const size_t MStringBatch::DEFAULT_PARALLEL_THRESHOLD;
+
+MStringBatchResult::MStringBatchResult(MStringBatchResult&& other)
+    : data_(std::move(other.data_)), length_(other.length_), offsets_(std::move(other.offsets_)),
+      indices_(std::move(other.indices_)) {
+    other.length_ = 0;
+    other.offsets_.assign(1, 0);
+}
+
+MStringBatchResult& MStringBatchResult::operator=(MStringBatchResult&& other) {
+    if (this != &other) {
+        data_ = std::move(other.data_);
+        length_ = other.length_;
+        offsets_ = std::move(other.offsets_);
+        indices_ = std::move(other.indices_);
+        other.length_ = 0;
+        other.offsets_.assign(1, 0);
+    }
+    return *this;
+}
+
+// 转换为独立的字符串
+std::vector<MString> MStringBatchResult::toVector() const {
+    std::vector<MString> strings;
+    strings.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        strings.push_back(MString((*this)[i]));
+    }
+    return strings;
+}
+
+void MStringBatch::setParallelThreshold(size_t count) {
+    g_parallelThreshold = count;
+}
+
+size_t MStringBatch::parallelThreshold() {
+    return g_parallelThreshold;
+}
+
+// 按元素下标区间处理：每个线程分到多段，以平衡元素长度不均造成的差异
+void MStringBatch::parallelFor(size_t count, const std::function<void(size_t, size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+    if (count < g_parallelThreshold) {
+        func(0, count);
+        return;
+    }
+    MStringWorkerPool& pool = MStringWorkerPool::instance();
+    if (pool.threadCount() == 1) {
+        func(0, count);
+        return;
+    }
+    size_t chunks = pool.threadCount() * 4;
+    if (chunks > count) {
+        chunks = count;
+    }
+    pool.run(chunks, [count, chunks, &func](size_t chunk) {
+        func(count * chunk / chunks, count * (chunk + 1) / chunks);
+    });
+}
+
+// 计算输出长度 -> 前缀和得到偏移 -> 分配连续缓冲区 -> 并行写入
+MStringBatchResult MStringBatch::build(size_t count, const std::function<size_t(size_t)>& lengthOf,
+                                       const std::function<void(size_t, char*)>& write) {
+    MStringBatchResult result;
+    std::vector<size_t>& offsets = result.offsets_;
+    offsets.resize(count + 1);
+    offsets[0] = 0;
+    parallelFor(count, [&offsets, &lengthOf](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            offsets[i + 1] = lengthOf(i);
+        }
+    });
+    for (size_t i = 0; i < count; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    result.length_ = offsets[count];
+    result.data_.reset(new char[result.length_ > 0 ? result.length_ : 1]);
+    char* data = result.data_.get();
+    parallelFor(count, [&offsets, &write, data](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            write(i, data + offsets[i]);
+        }
+    });
+    return result;
+}
+
+// 去除首尾空白字符
+MStringBatchResult MStringBatch::trim(const std::vector<MString>& strings) {
+    return build(strings.size(), [&strings](size_t i) {
+        return strings[i].view().trim().length();
+    }, [&strings](size_t i, char* out) {
+        MStringView trimmed = strings[i].view().trim();
+        memcpy(out, trimmed.data(), trimmed.length());
+    });
+}
+
+// 转换为小写
+MStringBatchResult MStringBatch::toLowerCase(const std::vector<MString>& strings) {
+    return build(strings.size(), [&strings](size_t i) {
+        return strings[i].length();
+    }, [&strings](size_t i, char* out) {
+        MStringSimd::toLower(out, strings[i].getData(), strings[i].length());
+    });
+}
+
+// 转换为大写
+MStringBatchResult MStringBatch::toUpperCase(const std::vector<MString>& strings) {
+    return build(strings.size(), [&strings](size_t i) {
+        return strings[i].length();
+    }, [&strings](size_t i, char* out) {
+        MStringSimd::toUpper(out, strings[i].getData(), strings[i].length());
+    });
+}
+
+// 过滤：先并行标记匹配的元素，再复制匹配的元素
+MStringBatchResult MStringBatch::filterContains(const std::vector<MString>& strings, MStringView needle) {
+    const MStringSearcher searcher(needle);
+    std::vector<char> matched(strings.size());
+    parallelFor(strings.size(), [&strings, &searcher, &matched](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            matched[i] = searcher.contains(strings[i].view());
+        }
+    });
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (matched[i]) {
+            indices.push_back(i);
+        }
+    }
+    MStringBatchResult result = build(indices.size(), [&strings, &indices](size_t i) {
+        return strings[indices[i]].length();
+    }, [&strings, &indices](size_t i, char* out) {
+        memcpy(out, strings[indices[i]].getData(), strings[indices[i]].length());
+    });
+    result.indices_.swap(indices);
+    return result;
+}
+
+// 替换：计算长度时统计匹配次数，写入时再次查找（与MString::replace一致）
+MStringBatchResult MStringBatch::replace(const std::vector<MString>& strings, MStringView find, MStringView replace) {
+    if (find.isEmpty()) {
+        return build(strings.size(), [&strings](size_t i) {
+            return strings[i].length();
+        }, [&strings](size_t i, char* out) {
+            memcpy(out, strings[i].getData(), strings[i].length());
+        });
+    }
+    const MStringSearcher searcher(find);
+    return build(strings.size(), [&strings, &searcher, find, replace](size_t i) {
+        size_t count = searcher.count(strings[i].view());
+        return strings[i].length() - count * find.length() + count * replace.length();
+    }, [&strings, &searcher, find, replace](size_t i, char* out) {
+        MStringView text = strings[i].view();
+        size_t copied = 0;
+        int pos;
+        while ((pos = searcher.find(text, copied)) != -1) {
+            memcpy(out, text.data() + copied, pos - copied);
+            out += pos - copied;
+            memcpy(out, replace.data(), replace.length());
+            out += replace.length();
+            copied = pos + find.length();
+        }
+        memcpy(out, text.data() + copied, text.length() - copied);
+    });
+}
@@ -0,0 +1,100 @@
+#ifndef MSTRINGBATCH_H
+#define MSTRINGBATCH_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "MString.h"
+
+// 批量操作结果：所有字符串首尾相接存放在一块缓冲区中，按偏移访问，不为每个元素单独分配内存
+// 只能移动不能拷贝，元素视图在结果销毁前有效
+class MStringBatchResult {
+public:
+    MStringBatchResult() : length_(0), offsets_(1, 0) {}
+
+    MStringBatchResult(MStringBatchResult&& other);
+    MStringBatchResult& operator=(MStringBatchResult&& other);
+
+    // 元素数量
+    size_t size() const {
+        return offsets_.size() - 1;
+    }
+
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    // 第index个元素
+    MStringView operator[](size_t index) const {
+        return MStringView(data_.get() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+    }
+
+    // 第index个元素在输入中的位置（过滤操作只保留部分元素）
+    size_t sourceIndex(size_t index) const {
+        return indices_.empty() ? index : indices_[index];
+    }
+
+    // 连续缓冲区及其总长度
+    const char* data() const {
+        return data_.get();
+    }
+
+    size_t dataLength() const {
+        return length_;
+    }
+
+    // 各元素的起始偏移，共size() + 1项，最后一项为总长度
+    const std::vector<size_t>& offsets() const {
+        return offsets_;
+    }
+
+    // 转换为独立的字符串
+    std::vector<MString> toVector() const;
+private:
+    friend class MStringBatch;
+
+    std::unique_ptr<char[]> data_;// 连续缓冲区
+    size_t length_;// 总长度
+    std::vector<size_t> offsets_;// 起始偏移
+    std::vector<size_t> indices_;// 在输入中的位置，为空表示与输入一一对应
+
+    MStringBatchResult(const MStringBatchResult&);
+    MStringBatchResult& operator=(const MStringBatchResult&);
+};
+
+// 批量字符串操作：元素数量达到阈值时切分为多段，由共享的工作线程池并行处理
+// 先并行计算每个元素的输出长度，分配一次连续缓冲区后再并行写入
+// 通过MString::batch调用：MString::batch::toLowerCase(strings)
+class MStringBatch {
+public:
+    // 去除首尾空白字符
+    static MStringBatchResult trim(const std::vector<MString>& strings);
+
+    // 转换为小写/大写
+    static MStringBatchResult toLowerCase(const std::vector<MString>& strings);
+    static MStringBatchResult toUpperCase(const std::vector<MString>& strings);
+
+    // 保留包含needle的元素，sourceIndex()返回其在输入中的位置
+    static MStringBatchResult filterContains(const std::vector<MString>& strings, MStringView needle);
+
+    // 将所有find替换为replace
+    static MStringBatchResult replace(const std::vector<MString>& strings, MStringView find, MStringView replace);
+
+    // 启用并行处理的最小元素数量，默认为DEFAULT_PARALLEL_THRESHOLD
+    static void setParallelThreshold(size_t count);
+    static size_t parallelThreshold();
+
+    static const size_t DEFAULT_PARALLEL_THRESHOLD = 8192;
+private:
+    MStringBatch();
+
+    // 按元素下标区间处理，数据量达到阈值时并行
+    static void parallelFor(size_t count, const std::function<void(size_t, size_t)>& func);
+
+    // 按输出长度分配连续缓冲区后写入：lengthOf(i)返回第i个输出的长度，write(i, out)写入
+    static MStringBatchResult build(size_t count, const std::function<size_t(size_t)>& lengthOf,
+                                    const std::function<void(size_t, char*)>& write);
+};
+
+#endif //MSTRINGBATCH_H
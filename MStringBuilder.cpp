@@ -0,0 +1,26 @@
+#include "MStringBuilder.h"
+
+// 构造函数：可预留容量
+MStringBuilder::MStringBuilder(size_t capacity) : len_(0) {
+    buffer_.reserve(capacity);
+    data_ = buffer_.mutableData();
+    cap_ = buffer_.capacity();
+}
+
+// 扩容，至少容纳minCapacity字节
+void MStringBuilder::grow(size_t minCapacity) {
+    buffer_.setLength(len_);// 同步长度，扩容时只拷贝有效数据
+    buffer_.reserve(buffer_.growCapacity(minCapacity));
+    data_ = buffer_.mutableData();
+    cap_ = buffer_.capacity();
+}
+
+// 生成 MString 并移交缓冲区，构建器重置为空
+MString MStringBuilder::build() {
+    buffer_.setLength(len_);
+    MString result(std::move(buffer_));
+    data_ = buffer_.mutableData();
+    len_ = 0;
+    cap_ = buffer_.capacity();
+    return result;
+}
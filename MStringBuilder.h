@@ -0,0 +1,143 @@
+#ifndef MSTRINGBUILDER_H
+#define MSTRINGBUILDER_H
+
+#include "MString.h"
+
+// 字符串构建器：向可增长缓冲区追加内容，build()时直接移交缓冲区给 MString，不产生额外拷贝
+class MStringBuilder {
+private:
+    MString buffer_;// 底层缓冲区，追加过程中其记录的长度不实时更新
+    char* data_;// 缓冲区起始位置
+    size_t len_;// 已写入长度
+    size_t cap_;// 缓冲区容量
+
+    // 扩容，至少容纳minCapacity字节
+    void grow(size_t minCapacity);
+
+    // 追加数值：直接格式化到缓冲区
+    template<typename T>
+    MStringBuilder& appendNumber(T value) {
+        if (MStringNumber::MAX_LENGTH > cap_ - len_) {
+            grow(len_ + MStringNumber::MAX_LENGTH);
+        }
+        len_ += MStringNumber::toChars(data_ + len_, value);
+        return *this;
+    }
+
+    // 私有化拷贝构造、赋值（data_指向自身缓冲区）
+    MStringBuilder(const MStringBuilder&);
+    MStringBuilder& operator=(const MStringBuilder&);
+public:
+    // 构造函数：可预留容量
+    explicit MStringBuilder(size_t capacity = 0);
+
+    // 追加指定长度的数据，s可以指向构建器自身（如 b.append(b.view())）
+    MStringBuilder& append(const char* s, size_t len) {
+        if (len > cap_ - len_) {
+            // 扩容会释放旧缓冲区，s指向自身时换算到新缓冲区
+            bool inside = s >= data_ && s < data_ + cap_;
+            size_t offset = inside ? s - data_ : 0;
+            grow(len_ + len);
+            if (inside) {
+                s = data_ + offset;
+            }
+        }
+        std::memcpy(data_ + len_, s, len);
+        len_ += len;
+        return *this;
+    }
+
+    // 追加字符串
+    MStringBuilder& append(const MString& str) {
+        return append(str.getData(), str.length());
+    }
+
+    // 追加字符串
+    MStringBuilder& append(const char* str) {
+        return append(str, strlen(str));
+    }
+
+    // 追加字符串
+    MStringBuilder& append(const std::string& str) {
+        return append(str.data(), str.size());
+    }
+
+    // 追加视图
+    MStringBuilder& append(MStringView view) {
+        return append(view.data(), view.length());
+    }
+
+    // 追加拼接表达式
+    template<typename L, typename R>
+    MStringBuilder& append(const MStringConcat<L, R>& expr) {
+        size_t len = expr.length();
+        if (len > cap_ - len_) {
+            // 表达式可能引用构建器自身的内容，扩容前先生成结果
+            MString str(expr);
+            return append(str.getData(), str.length());
+        }
+        expr.writeTo(data_ + len_);
+        len_ += len;
+        return *this;
+    }
+
+    // 追加单个字符
+    MStringBuilder& append(char c) {
+        if (len_ == cap_) {
+            grow(len_ + 1);
+        }
+        data_[len_++] = c;
+        return *this;
+    }
+
+    // 追加整数（十进制）
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value,
+        MStringBuilder&>::type append(T value) {
+        return appendNumber(value);
+    }
+
+    // 追加浮点数
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, MStringBuilder&>::type append(T value) {
+        return appendNumber(value);
+    }
+
+    // 流式追加：builder << "id=" << 1;
+    template<typename T>
+    MStringBuilder& operator<<(const T& value) {
+        return append(value);
+    }
+
+    // 已写入长度
+    size_t length() const {
+        return len_;
+    }
+
+    // 缓冲区容量
+    size_t capacity() const {
+        return cap_;
+    }
+
+    // 预留容量
+    void reserve(size_t capacity) {
+        if (capacity > cap_) {
+            grow(capacity);
+        }
+    }
+
+    // 清空内容，保留容量以便复用
+    void clear() {
+        len_ = 0;
+    }
+
+    // 当前内容的视图（后续追加可能使其失效）
+    MStringView view() const {
+        return MStringView(data_, len_);
+    }
+
+    // 生成 MString 并移交缓冲区，构建器重置为空
+    MString build();
+};
+
+#endif //MSTRINGBUILDER_H
@@ -0,0 +1,77 @@
+#include "MStringCodePoint.h"
+#include "MStringSimd.h"
+
+const uint32_t MStringCodePoints::REPLACEMENT;
+const size_t MStringCodePointIndex::STRIDE;
+
+// 解码一个非ASCII码点，拒绝过长编码、代理区和超过U+10FFFF的码点
+size_t MStringCodePoints::decode(const char* pos, const char* end, uint32_t& codePoint) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(pos);
+    size_t avail = end - pos;
+    unsigned lead = s[0];
+    size_t n = 0;
+    unsigned low = 0x80;// 第二字节的取值范围
+    unsigned high = 0xBF;
+    uint32_t cp = 0;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        n = 2;
+        cp = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        n = 3;
+        cp = lead & 0x0F;
+        low = lead == 0xE0 ? 0xA0 : low;
+        high = lead == 0xED ? 0x9F : high;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        n = 4;
+        cp = lead & 0x07;
+        low = lead == 0xF0 ? 0x90 : low;
+        high = lead == 0xF4 ? 0x8F : high;
+    }
+    if (n == 0 || avail < n || s[1] < low || s[1] > high) {
+        codePoint = REPLACEMENT;
+        return 1;
+    }
+    cp = (cp << 6) | (s[1] & 0x3F);
+    for (size_t i = 2; i < n; ++i) {
+        if ((s[i] & 0xC0) != 0x80) {
+            codePoint = REPLACEMENT;
+            return 1;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    codePoint = cp;
+    return n;
+}
+
+// 构造函数：一次扫描记录每STRIDE个码点的字节偏移
+MStringCodePointIndex::MStringCodePointIndex(MStringView text) : text_(text), length_(0) {
+    const char* data = text.data();
+    size_t len = text.length();
+    size_t pos = MStringSimd::codePointOffset(data, len, 0);
+    while (pos < len) {
+        offsets_.push_back(pos);
+        size_t step = MStringSimd::codePointOffset(data + pos, len - pos, STRIDE);
+        if (pos + step == len) {
+            length_ += MStringSimd::countCodePoints(data + pos, len - pos);
+            break;
+        }
+        length_ += STRIDE;
+        pos += step;
+    }
+}
+
+// 第index个码点的字节偏移
+size_t MStringCodePointIndex::offset(size_t index) const {
+    if (index >= length_) {
+        return text_.length();
+    }
+    size_t base = offsets_[index / STRIDE];
+    return base + MStringSimd::codePointOffset(text_.data() + base, text_.length() - base, index % STRIDE);
+}
+
+// 返回从第pos个码点开始的n个码点，开头不属于任何码点的后续字节归入第0个码点
+MStringView MStringCodePointIndex::mid(size_t pos, size_t n) const {
+    size_t start = pos == 0 ? 0 : offset(pos);
+    size_t end = pos < length_ && n < length_ - pos ? offset(pos + n) : text_.length();
+    return MStringView(text_.data() + start, end - start);
+}
@@ -0,0 +1,123 @@
+#ifndef MSTRINGCODEPOINT_H
+#define MSTRINGCODEPOINT_H
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "MStringView.h"
+
+// 按码点遍历UTF-8字符串：解引用得到码点值，非法序列的每个字节解码为U+FFFD
+// 非法UTF-8下遍历个数与codePointLength()不同，后者只对合法的UTF-8有定义
+// 区间引用原字符串，使用期间原字符串必须保持有效
+//   for (uint32_t cp : str.codePoints()) { ... }
+class MStringCodePoints {
+public:
+    // 替换非法序列的码点
+    static const uint32_t REPLACEMENT = 0xFFFD;
+
+    // 前向迭代器
+    class Iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef uint32_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const uint32_t* pointer;
+        typedef uint32_t reference;
+
+        Iterator() : pos_(nullptr), end_(nullptr), len_(0), codePoint_(0) {}
+
+        Iterator(const char* pos, const char* end) : pos_(pos), end_(end), len_(0), codePoint_(0) {
+            decode();
+        }
+
+        uint32_t operator*() const {
+            return codePoint_;
+        }
+
+        // 当前码点对应的字节
+        MStringView view() const {
+            return MStringView(pos_, len_);
+        }
+
+        Iterator& operator++() {
+            pos_ += len_;
+            decode();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.pos_ == b.pos_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.pos_ != b.pos_;
+        }
+    private:
+        // 解码当前位置的码点，ASCII直接处理
+        void decode() {
+            if (pos_ == end_) {
+                len_ = 0;
+            } else if (static_cast<unsigned char>(*pos_) < 0x80) {
+                codePoint_ = static_cast<unsigned char>(*pos_);
+                len_ = 1;
+            } else {
+                len_ = MStringCodePoints::decode(pos_, end_, codePoint_);
+            }
+        }
+
+        const char* pos_;// 当前码点的起始位置
+        const char* end_;
+        size_t len_;// 当前码点的字节数
+        uint32_t codePoint_;
+    };
+
+    explicit MStringCodePoints(MStringView text) : text_(text) {}
+
+    Iterator begin() const {
+        return Iterator(text_.begin(), text_.end());
+    }
+
+    Iterator end() const {
+        return Iterator(text_.end(), text_.end());
+    }
+
+    // 解码pos处的一个非ASCII码点，返回字节数；非法序列返回1，码点为REPLACEMENT
+    static size_t decode(const char* pos, const char* end, uint32_t& codePoint);
+private:
+    MStringView text_;
+};
+
+// 码点偏移索引：每隔STRIDE个码点记录一次字节偏移，随机访问只需从最近的记录点开始计数
+// 与codePointLength()相同按非后续字节计数，只对合法的UTF-8有定义
+// 需要对同一字符串反复按码点截取时使用，索引引用原字符串，使用期间原字符串必须保持有效
+//   MStringCodePointIndex index(name.view());
+//   MStringView surname = index.mid(0, 1);
+class MStringCodePointIndex {
+public:
+    explicit MStringCodePointIndex(MStringView text);
+
+    // 码点数
+    size_t length() const {
+        return length_;
+    }
+
+    // 第index个码点的字节偏移，超出时返回字节长度
+    size_t offset(size_t index) const;
+
+    // 返回从第pos个码点开始的n个码点
+    MStringView mid(size_t pos, size_t n) const;
+private:
+    static const size_t STRIDE = 64;
+
+    MStringView text_;
+    size_t length_;// 码点数
+    std::vector<size_t> offsets_;// 第0、STRIDE、2*STRIDE...个码点的字节偏移
+};
+
+#endif //MSTRINGCODEPOINT_H
@@ -0,0 +1,244 @@
+#include "MStringCodec.h"
+#include "MStringSimd.h"
+#include <cstring>
+#include <cstdint>
+
+static const char* BASE64_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const unsigned char BASE64_INVALID = 0xFF;
+
+// 查找表：十六进制每字节对应的两个字符；Base64每12位对应的两个字符，以及字符对应的6位值
+struct CodecTable {
+    char hexUpper[256 * 2];
+    char hexLower[256 * 2];
+    char base64Encode[4096 * 2];
+    unsigned char base64Decode[256];// 非法字符（含'='）为BASE64_INVALID
+
+    CodecTable() {
+        for (int i = 0; i < 256; ++i) {
+            hexUpper[2 * i] = "0123456789ABCDEF"[i >> 4];
+            hexUpper[2 * i + 1] = "0123456789ABCDEF"[i & 0x0F];
+            hexLower[2 * i] = "0123456789abcdef"[i >> 4];
+            hexLower[2 * i + 1] = "0123456789abcdef"[i & 0x0F];
+        }
+        for (int i = 0; i < 4096; ++i) {
+            base64Encode[2 * i] = BASE64_ALPHABET[i >> 6];
+            base64Encode[2 * i + 1] = BASE64_ALPHABET[i & 0x3F];
+        }
+        memset(base64Decode, BASE64_INVALID, sizeof(base64Decode));
+        for (int i = 0; i < 64; ++i) {
+            base64Decode[static_cast<unsigned char>(BASE64_ALPHABET[i])] = static_cast<unsigned char>(i);
+        }
+    }
+};
+
+static const CodecTable& codecTable() {
+    static const CodecTable table;
+    return table;
+}
+
+// 十六进制字符的值，非法字符返回-1
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    char lower = static_cast<char>(c | 0x20);
+    return (lower >= 'a' && lower <= 'f') ? lower - 'a' + 10 : -1;
+}
+
+static MStringConvertResult makeResult(MStringConvertError error, size_t read, size_t written) {
+    MStringConvertResult result = { error, read, written };
+    return result;
+}
+
+// 十六进制编码后的长度
+size_t MStringCodec::hexEncodedLength(size_t len, size_t separatorLen) {
+    return len == 0 ? 0 : len * (2 + separatorLen) - separatorLen;
+}
+
+// 十六进制编码：无分隔符时使用SIMD，有分隔符时逐字节查表
+size_t MStringCodec::hexEncode(char* out, const char* data, size_t len, MStringView separator, bool upperCase) {
+    if (separator.isEmpty()) {
+        MStringSimd::hexEncode(out, data, len, upperCase);
+        return 2 * len;
+    }
+    const char* pairs = upperCase ? codecTable().hexUpper : codecTable().hexLower;
+    char* pos = out;
+    for (size_t i = 0; i < len; ++i) {
+        if (i != 0) {
+            if (separator.length() == 1) {
+                *pos++ = separator[0];
+            } else {
+                memcpy(pos, separator.data(), separator.length());
+                pos += separator.length();
+            }
+        }
+        memcpy(pos, pairs + 2 * static_cast<unsigned char>(data[i]), 2);
+        pos += 2;
+    }
+    return pos - out;
+}
+
+// 十六进制解码后的最大长度
+size_t MStringCodec::hexDecodedMaxLength(size_t len, size_t separatorLen) {
+    return (len + separatorLen) / (2 + separatorLen);
+}
+
+// 十六进制解码：无分隔符时使用SIMD，遇到非法字符后再定位出错位置
+MStringConvertResult MStringCodec::hexDecode(const char* input, size_t len, char* output, size_t outSize, MStringView separator) {
+    if (separator.isEmpty()) {
+        size_t bytes = len / 2;
+        size_t limit = bytes < outSize ? bytes : outSize;
+        size_t written = MStringSimd::hexDecode(output, input, limit);
+        if (written < limit) {
+            size_t pos = 2 * written + (hexValue(input[2 * written]) >= 0 ? 1 : 0);
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos, written);
+        }
+        if (written < bytes) {
+            return makeResult(MStringConvertError::CONVERT_OUTPUT_FULL, 2 * written, written);
+        }
+        if (len % 2 != 0) {
+            bool valid = hexValue(input[len - 1]) >= 0;
+            return makeResult(valid ? MStringConvertError::CONVERT_INCOMPLETE : MStringConvertError::CONVERT_INVALID, len - 1, written);
+        }
+        return makeResult(MStringConvertError::CONVERT_OK, len, written);
+    }
+
+    size_t pos = 0;
+    size_t written = 0;
+    while (pos < len) {
+        size_t start = pos;
+        if (written != 0) {
+            // 字节之间必须是完整的分隔符
+            size_t n = separator.length() < len - pos ? separator.length() : len - pos;
+            for (size_t i = 0; i < n; ++i) {
+                if (input[pos + i] != separator[i]) {
+                    return makeResult(MStringConvertError::CONVERT_INVALID, pos + i, written);
+                }
+            }
+            pos += separator.length();
+            if (pos >= len) {
+                return makeResult(MStringConvertError::CONVERT_INCOMPLETE, start, written);
+            }
+        }
+        int high = hexValue(input[pos]);
+        if (high < 0) {
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos, written);
+        }
+        if (pos + 1 >= len) {
+            return makeResult(MStringConvertError::CONVERT_INCOMPLETE, start, written);
+        }
+        int low = hexValue(input[pos + 1]);
+        if (low < 0) {
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos + 1, written);
+        }
+        if (written >= outSize) {
+            return makeResult(MStringConvertError::CONVERT_OUTPUT_FULL, start, written);
+        }
+        output[written++] = static_cast<char>((high << 4) | low);
+        pos += 2;
+    }
+    return makeResult(MStringConvertError::CONVERT_OK, len, written);
+}
+
+// Base64编码后的长度
+size_t MStringCodec::base64EncodedLength(size_t len) {
+    return (len + 2) / 3 * 4;
+}
+
+// Base64编码：每3字节拆为两个12位，各查表得到两个字符
+size_t MStringCodec::base64Encode(char* out, const char* data, size_t len) {
+    const CodecTable& table = codecTable();
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    char* pos = out;
+    size_t i = 0;
+    for (; i + 3 <= len; i += 3) {
+        uint32_t bits = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+        memcpy(pos, table.base64Encode + 2 * (bits >> 12), 2);
+        memcpy(pos + 2, table.base64Encode + 2 * (bits & 0xFFF), 2);
+        pos += 4;
+    }
+    if (i < len) {
+        uint32_t bits = static_cast<uint32_t>(in[i]) << 16;
+        if (i + 1 < len) {
+            bits |= static_cast<uint32_t>(in[i + 1]) << 8;
+        }
+        memcpy(pos, table.base64Encode + 2 * (bits >> 12), 2);
+        pos[2] = i + 1 < len ? BASE64_ALPHABET[(bits >> 6) & 0x3F] : '=';
+        pos[3] = '=';
+        pos += 4;
+    }
+    return pos - out;
+}
+
+// Base64解码后的最大长度
+size_t MStringCodec::base64DecodedMaxLength(size_t len) {
+    return len / 4 * 3;
+}
+
+// Base64解码：4个字符均合法时直接合并为3字节，否则按填充规则逐个校验
+MStringConvertResult MStringCodec::base64Decode(const char* input, size_t len, char* output, size_t outSize) {
+    const unsigned char* table = codecTable().base64Decode;
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(input);
+    size_t pos = 0;
+    size_t written = 0;
+    while (pos < len) {
+        if (len - pos < 4) {
+            for (size_t i = pos; i < len; ++i) {
+                if (table[in[i]] == BASE64_INVALID) {
+                    return makeResult(MStringConvertError::CONVERT_INVALID, i, written);
+                }
+            }
+            return makeResult(MStringConvertError::CONVERT_INCOMPLETE, pos, written);
+        }
+        uint32_t a = table[in[pos]];
+        uint32_t b = table[in[pos + 1]];
+        uint32_t c = table[in[pos + 2]];
+        uint32_t d = table[in[pos + 3]];
+        if (((a | b | c | d) & 0x80) == 0) {
+            if (outSize - written < 3) {
+                return makeResult(MStringConvertError::CONVERT_OUTPUT_FULL, pos, written);
+            }
+            uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+            output[written] = static_cast<char>(bits >> 16);
+            output[written + 1] = static_cast<char>(bits >> 8);
+            output[written + 2] = static_cast<char>(bits);
+            written += 3;
+            pos += 4;
+            continue;
+        }
+
+        // 含非法字符或填充：填充只能出现在最后一组，且被舍弃的位必须为0
+        bool last = pos + 4 == len;
+        if (a == BASE64_INVALID) {
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos, written);
+        }
+        if (b == BASE64_INVALID) {
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos + 1, written);
+        }
+        size_t bytes = 0;
+        if (last && in[pos + 2] == '=' && in[pos + 3] == '=') {
+            if ((b & 0x0F) != 0) {
+                return makeResult(MStringConvertError::CONVERT_INVALID, pos + 1, written);
+            }
+            bytes = 1;
+        } else if (c == BASE64_INVALID) {
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos + 2, written);
+        } else if (last && in[pos + 3] == '=') {
+            if ((c & 0x03) != 0) {
+                return makeResult(MStringConvertError::CONVERT_INVALID, pos + 2, written);
+            }
+            bytes = 2;
+        } else {
+            return makeResult(MStringConvertError::CONVERT_INVALID, pos + 3, written);
+        }
+        if (outSize - written < bytes) {
+            return makeResult(MStringConvertError::CONVERT_OUTPUT_FULL, pos, written);
+        }
+        output[written++] = static_cast<char>((a << 2) | (b >> 4));
+        if (bytes == 2) {
+            output[written++] = static_cast<char>((b << 4) | (c >> 2));
+        }
+        pos += 4;
+    }
+    return makeResult(MStringConvertError::CONVERT_OK, len, written);
+}
@@ -0,0 +1,43 @@
+#ifndef MSTRINGCODEC_H
+#define MSTRINGCODEC_H
+
+#include <cstddef>
+#include "MStringView.h"
+#include "MStringEncoding.h"
+
+// 二进制数据与文本之间的编解码（十六进制、Base64）：写入调用方提供的缓冲区，不分配内存
+// 解码严格校验输入，出错时MStringConvertResult::read为出错字符在输入中的位置：
+//   CONVERT_INVALID     非法字符、分隔符不匹配、填充位置错误或填充前的剩余位不为0
+//   CONVERT_INCOMPLETE  输入在一个字节（十六进制）或一组4字符（Base64）中间结束
+//   CONVERT_OUTPUT_FULL 输出缓冲区不足，已解码的部分有效
+class MStringCodec {
+public:
+    // len字节十六进制编码后的长度：每字节2个字符，字节之间插入分隔符
+    static size_t hexEncodedLength(size_t len, size_t separatorLen);
+
+    // 十六进制编码，out至少容纳hexEncodedLength字节，返回写入长度
+    static size_t hexEncode(char* out, const char* data, size_t len, MStringView separator = MStringView(), bool upperCase = true);
+
+    // len个字符十六进制解码后的最大长度
+    static size_t hexDecodedMaxLength(size_t len, size_t separatorLen);
+
+    // 十六进制解码：大小写均可，字节之间必须恰好是separator（首尾不允许分隔符）
+    static MStringConvertResult hexDecode(const char* input, size_t len, char* output, size_t outSize,
+                                          MStringView separator = MStringView());
+
+    // len字节Base64编码后的长度
+    static size_t base64EncodedLength(size_t len);
+
+    // Base64编码（标准字母表，以'='填充），out至少容纳base64EncodedLength字节，返回写入长度
+    static size_t base64Encode(char* out, const char* data, size_t len);
+
+    // len个字符Base64解码后的最大长度
+    static size_t base64DecodedMaxLength(size_t len);
+
+    // Base64解码：只接受标准字母表和规范的'='填充，不允许空白字符
+    static MStringConvertResult base64Decode(const char* input, size_t len, char* output, size_t outSize);
+private:
+    MStringCodec();
+};
+
+#endif //MSTRINGCODEC_H
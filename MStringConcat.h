@@ -0,0 +1,243 @@
+#ifndef MSTRINGCONCAT_H
+#define MSTRINGCONCAT_H
+
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include "MStringView.h"
+#include "MStringNumber.h"
+
+class MString;
+
+template<typename L, typename R>
+class MStringConcat;
+
+// 数值操作数：构造时格式化到内部缓冲区（char按字符处理，与MString赋值一致）
+class MStringConcatNumber {
+private:
+    char data_[MStringNumber::MAX_LENGTH];
+    size_t len_;
+public:
+    explicit MStringConcatNumber(char c) : len_(1) {
+        data_[0] = c;
+    }
+
+    template<typename T>
+    explicit MStringConcatNumber(T value) : len_(MStringNumber::toChars(data_, value)) {}
+
+    MStringView view() const {
+        return MStringView(data_, len_);
+    }
+};
+
+// 拼接片段长度
+inline size_t concatLength(const MStringConcatNumber& number) {
+    return number.view().length();
+}
+
+inline size_t concatLength(MStringView view) {
+    return view.length();
+}
+
+template<typename L, typename R>
+inline size_t concatLength(const MStringConcat<L, R>& expr) {
+    return expr.length();
+}
+
+// 写入拼接片段，返回写入结束位置
+inline char* concatWrite(char* out, const MStringConcatNumber& number) {
+    MStringView view = number.view();
+    std::memcpy(out, view.data(), view.length());
+    return out + view.length();
+}
+
+inline char* concatWrite(char* out, MStringView view) {
+    std::memcpy(out, view.data(), view.length());
+    return out + view.length();
+}
+
+template<typename L, typename R>
+inline char* concatWrite(char* out, const MStringConcat<L, R>& expr) {
+    return expr.writeTo(out);
+}
+
+// 拼接片段与other的前缀逐字节比较，相等时other跳过已比较的部分
+inline int concatCompare(MStringView view, MStringView& other) {
+    size_t n = view.length() < other.length() ? view.length() : other.length();
+    int result = n > 0 ? std::memcmp(view.data(), other.data(), n) : 0;
+    if (result != 0) {
+        return result;
+    }
+    if (view.length() > other.length()) {
+        return 1;
+    }
+    other = MStringView(other.data() + n, other.length() - n);
+    return 0;
+}
+
+inline int concatCompare(const MStringConcatNumber& number, MStringView& other) {
+    return concatCompare(number.view(), other);
+}
+
+template<typename L, typename R>
+inline int concatCompare(const MStringConcat<L, R>& expr, MStringView& other) {
+    return expr.compareTo(other);
+}
+
+// 延迟拼接表达式：a + ", " + b 只记录各操作数，转换为 MString 时一次性计算总长度、分配一次内存并逐段拷贝
+// 表达式保存的是操作数的视图，必须在同一个完整表达式内使用（不要用auto保存表达式）
+template<typename L, typename R>
+class MStringConcat {
+private:
+    L left_;// 左操作数：MStringView、MStringConcatNumber 或 MStringConcat
+    R right_;// 右操作数：MStringView、MStringConcatNumber 或 MStringConcat
+public:
+    MStringConcat(const L& left, const R& right) : left_(left), right_(right) {}
+
+    // 拼接结果的总长度
+    size_t length() const {
+        return concatLength(left_) + concatLength(right_);
+    }
+
+    // 写入拼接结果（不写结尾'\0'），返回写入结束位置
+    char* writeTo(char* out) const {
+        return concatWrite(concatWrite(out, left_), right_);
+    }
+
+    // 逐段输出到流，不生成中间字符串
+    void writeTo(std::ostream& os) const {
+        concatWrite(os, left_);
+        concatWrite(os, right_);
+    }
+
+    // 逐段与other的前缀比较，相等时other跳过已比较的部分
+    int compareTo(MStringView& other) const {
+        int result = concatCompare(left_, other);
+        return result != 0 ? result : concatCompare(right_, other);
+    }
+};
+
+// 输出拼接片段到流
+inline void concatWrite(std::ostream& os, MStringView view) {
+    os.write(view.data(), view.length());
+}
+
+inline void concatWrite(std::ostream& os, const MStringConcatNumber& number) {
+    concatWrite(os, number.view());
+}
+
+template<typename L, typename R>
+inline void concatWrite(std::ostream& os, const MStringConcat<L, R>& expr) {
+    expr.writeTo(os);
+}
+
+template<typename L, typename R>
+inline std::ostream& operator<<(std::ostream& os, const MStringConcat<L, R>& expr) {
+    expr.writeTo(os);
+    return os;
+}
+
+// 拼接操作数类型：MString、const char*、std::string、视图保存为视图，数值格式化后保存，表达式保存为自身
+template<typename T, typename Enable = void>
+struct MStringConcatOperand {
+    static const bool value = false;
+    static const bool isString = false;
+};
+
+template<typename T>
+struct MStringConcatOperand<T, typename std::enable_if<
+    std::is_same<T, MString>::value || std::is_same<T, MStringView>::value || std::is_same<T, std::string>::value ||
+    std::is_same<typename std::decay<T>::type, const char*>::value ||
+    std::is_same<typename std::decay<T>::type, char*>::value>::type> {
+    static const bool value = true;
+    static const bool isString = std::is_same<T, MString>::value;
+    typedef MStringView type;
+};
+
+template<typename T>
+struct MStringConcatOperand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static const bool value = true;
+    static const bool isString = false;
+    typedef MStringConcatNumber type;
+};
+
+template<typename L, typename R>
+struct MStringConcatOperand<MStringConcat<L, R>> {
+    static const bool value = true;
+    static const bool isString = true;
+    typedef MStringConcat<L, R> type;
+};
+
+// 至少一侧为 MString 或拼接表达式时才启用 operator+，避免影响 std::string 等类型自身的拼接
+template<typename A, typename B>
+struct MStringConcatEnabled {
+    static const bool value = MStringConcatOperand<A>::value && MStringConcatOperand<B>::value &&
+                              (MStringConcatOperand<A>::isString || MStringConcatOperand<B>::isString);
+};
+
+// 字符串连接：返回延迟拼接表达式
+template<typename A, typename B>
+inline typename std::enable_if<MStringConcatEnabled<A, B>::value,
+    MStringConcat<typename MStringConcatOperand<A>::type, typename MStringConcatOperand<B>::type>>::type
+operator+(const A& a, const B& b) {
+    typedef typename MStringConcatOperand<A>::type Left;
+    typedef typename MStringConcatOperand<B>::type Right;
+    return MStringConcat<Left, Right>(Left(a), Right(b));
+}
+
+// 比较拼接结果与字符串：逐段比较，不生成中间字符串
+template<typename L, typename R>
+inline bool concatEquals(const MStringConcat<L, R>& expr, MStringView text) {
+    return expr.length() == text.length() && expr.compareTo(text) == 0;
+}
+
+template<typename L, typename R>
+inline bool concatEquals(MStringView text, const MStringConcat<L, R>& expr) {
+    return concatEquals(expr, text);
+}
+
+// 两侧都是拼接表达式时先生成右侧
+template<typename L1, typename R1, typename L2, typename R2>
+inline bool concatEquals(const MStringConcat<L1, R1>& a, const MStringConcat<L2, R2>& b) {
+    size_t len = b.length();
+    if (a.length() != len) {
+        return false;
+    }
+    std::string text(len, '\0');
+    if (len > 0) {
+        b.writeTo(&text[0]);
+    }
+    return concatEquals(a, MStringView(text.data(), len));
+}
+
+// 至少一侧为拼接表达式、另一侧为字符串类操作数（数值除外）时才启用比较
+template<typename T>
+struct MStringConcatIsExpr {
+    static const bool value = false;
+};
+
+template<typename L, typename R>
+struct MStringConcatIsExpr<MStringConcat<L, R>> {
+    static const bool value = true;
+};
+
+template<typename A, typename B>
+struct MStringConcatComparable {
+    static const bool value = MStringConcatOperand<A>::value && MStringConcatOperand<B>::value &&
+                              !std::is_arithmetic<A>::value && !std::is_arithmetic<B>::value &&
+                              (MStringConcatIsExpr<A>::value || MStringConcatIsExpr<B>::value);
+};
+
+// 比较运算：if (a + b == c)
+template<typename A, typename B>
+inline typename std::enable_if<MStringConcatComparable<A, B>::value, bool>::type operator==(const A& a, const B& b) {
+    return concatEquals(typename MStringConcatOperand<A>::type(a), typename MStringConcatOperand<B>::type(b));
+}
+
+template<typename A, typename B>
+inline typename std::enable_if<MStringConcatComparable<A, B>::value, bool>::type operator!=(const A& a, const B& b) {
+    return !(a == b);
+}
+
+#endif //MSTRINGCONCAT_H
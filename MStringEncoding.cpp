@@ -0,0 +1,578 @@
+#include "MStringEncoding.h"
+#include "MStringSimd.h"
+#include <cstring>
+#include <cstdint>
+#include "MStringGbkTable.h"
+
+// 引导字节对应的序列长度（非法的引导字节在校验时报错）
+static size_t utf8LeadLength(unsigned char lead) {
+    return lead >= 0xF0 ? 4 : (lead >= 0xE0 ? 3 : 2);
+}
+
+MStringUtf8Validator::MStringUtf8Validator() : pendingLen_(0), valid_(true) {
+}
+
+// 校验下一块数据
+bool MStringUtf8Validator::update(const char* data, size_t len) {
+    if (!valid_) {
+        return false;
+    }
+
+    // 先补全上一块末尾未完成的序列
+    if (pendingLen_ > 0) {
+        size_t need = utf8LeadLength(pending_[0]) - pendingLen_;
+        size_t n = need < len ? need : len;
+        memcpy(pending_ + pendingLen_, data, n);
+        pendingLen_ += n;
+        data += n;
+        len -= n;
+        if (n < need) {
+            return true;
+        }
+        valid_ = MStringSimd::validateUtf8(reinterpret_cast<const char*>(pending_), pendingLen_);
+        pendingLen_ = 0;
+        if (!valid_) {
+            return false;
+        }
+    }
+
+    // 末尾3个字节内的引导字节需要的后续字节不在本块中时，留到下一块
+    size_t cut = len;
+    for (size_t k = 1; k <= 3 && k <= len; ++k) {
+        unsigned char c = static_cast<unsigned char>(data[len - k]);
+        if (c >= 0xC0) {
+            if (utf8LeadLength(c) > k) {
+                cut = len - k;
+            }
+            break;
+        }
+        if (c < 0x80) {
+            break;
+        }
+    }
+    valid_ = MStringSimd::validateUtf8(data, cut);
+    if (valid_) {
+        pendingLen_ = len - cut;
+        memcpy(pending_, data + cut, pendingLen_);
+    }
+    return valid_;
+}
+
+// 重新开始
+void MStringUtf8Validator::reset() {
+    pendingLen_ = 0;
+    valid_ = true;
+}
+
+MStringEncodingDetector::MStringEncodingDetector() {
+    reset();
+}
+
+// 传入下一块数据
+void MStringEncodingDetector::update(const char* data, size_t len) {
+    while (headLen_ < sizeof(head_) && len > 0) {
+        head_[headLen_++] = static_cast<unsigned char>(*data++);
+        len--;
+        total_++;
+        if (head_[headLen_ - 1] == 0) {
+            zeroCount_[(total_ - 1) & 1]++;
+        }
+        nonAscii_ = nonAscii_ || head_[headLen_ - 1] >= 0x80;
+        utf8_.update(reinterpret_cast<const char*>(head_ + headLen_ - 1), 1);
+    }
+    if (len == 0 || bomEncoding() != StringEncoding_Unknown) {
+        return;// 有BOM时无需继续分析
+    }
+
+    // 0字节分布只统计开头部分，文本中没有0字节时由memchr快速跳过
+    if (total_ < UTF16_SAMPLE_SIZE) {
+        size_t n = UTF16_SAMPLE_SIZE - total_ < len ? UTF16_SAMPLE_SIZE - total_ : len;
+        if (memchr(data, 0, n) != nullptr) {
+            for (size_t i = 0; i < n; ++i) {
+                if (data[i] == 0) {
+                    zeroCount_[(total_ + i) & 1]++;
+                }
+            }
+        }
+    } else if (!utf8_.isValid()) {
+        total_ += len;
+        return;// 已确定不是UTF-8，后续数据不影响结果
+    }
+    if (!nonAscii_) {
+        nonAscii_ = MStringSimd::asciiLength(data, len) < len;
+    }
+    utf8_.update(data, len);
+    total_ += len;
+}
+
+// 根据开头的字节判断BOM
+StringEncoding MStringEncodingDetector::bomEncoding() const {
+    /*
+    Unicode little endian    文本里前两个字节为FF FE			字节流是little endian
+    Unicode big endian       文本里前两个字节为FE FF			字节流是big endian
+    UTF-8带BOM               前两字节为EF BB，第三字节为BF		带BOM
+    */
+    if (headLen_ >= 2 && head_[0] == 0xFF && head_[1] == 0xFE) {
+        return StringEncoding_UTF16_LE;
+    }
+    if (headLen_ >= 2 && head_[0] == 0xFE && head_[1] == 0xFF) {
+        return StringEncoding_UTF16_BE;
+    }
+    if (headLen_ >= 3 && head_[0] == 0xEF && head_[1] == 0xBB && head_[2] == 0xBF) {
+        return StringEncoding_UTF8_BOM;
+    }
+    return StringEncoding_Unknown;
+}
+
+// 根据目前为止传入的数据给出检测结果
+StringEncoding MStringEncodingDetector::result() const {
+    if (total_ == 0) {
+        return StringEncoding_Empty;
+    }
+    StringEncoding bom = bomEncoding();
+    if (bom != StringEncoding_Unknown) {
+        return bom;
+    }
+
+    // 不带BOM的UTF-16：ASCII字符的高字节为0，小端时出现在奇数偏移，大端时出现在偶数偏移
+    size_t even = zeroCount_[0];
+    size_t odd = zeroCount_[1];
+    size_t units = (total_ < UTF16_SAMPLE_SIZE ? total_ : UTF16_SAMPLE_SIZE) / 2;
+    if (even + odd > 0) {
+        if (odd > even * 4 && odd * 16 >= units) {
+            return StringEncoding_UTF16_LE;
+        }
+        if (even > odd * 4 && even * 16 >= units) {
+            return StringEncoding_UTF16_BE;
+        }
+        return StringEncoding_Unknown;// 文本中不应出现0字节，可能是二进制数据
+    }
+
+    // 纯ASCII按ANSI处理
+    return nonAscii_ && utf8_.finish() ? StringEncoding_UTF8 : StringEncoding_ANSI;
+}
+
+// 重新开始
+void MStringEncodingDetector::reset() {
+    headLen_ = 0;
+    total_ = 0;
+    zeroCount_[0] = zeroCount_[1] = 0;
+    nonAscii_ = false;
+    utf8_.reset();
+}
+
+// 一次性检测整块数据
+StringEncoding MStringEncodingDetector::detect(const char* data, size_t len) {
+    MStringEncodingDetector detector;
+    detector.update(data, len);
+    return detector.result();
+}
+
+// 解码结果：大于0为消耗的字节数
+static const int DECODE_INCOMPLETE = 0;// 输入在序列中间结束
+static const int DECODE_INVALID = -1;// 非法序列
+
+// GBK双字节编码与Unicode（BMP）之间的映射表：解码方向直接使用内置的静态表，编码方向由其反转得到
+struct GbkTable {
+    static const unsigned LEAD_MIN = 0x81;
+    static const unsigned LEAD_MAX = 0xFE;
+    static const unsigned TRAIL_MIN = 0x40;
+    static const unsigned TRAIL_MAX = 0xFE;
+    static const unsigned TRAIL_COUNT = TRAIL_MAX - TRAIL_MIN + 1;
+
+    const uint16_t* decode;// GBK -> UTF-16，0表示无映射
+    uint16_t encode[0x10000];// UTF-16 -> GBK（引导字节在高8位），0表示无映射
+
+    GbkTable() : decode(MSTRING_GBK_TO_UNICODE) {
+        static_assert(sizeof(MSTRING_GBK_TO_UNICODE) / sizeof(MSTRING_GBK_TO_UNICODE[0]) ==
+                      (LEAD_MAX - LEAD_MIN + 1) * TRAIL_COUNT, "GBK table size mismatch");
+        memset(encode, 0, sizeof(encode));
+        // 多个GBK编码对应同一字符时编码方向取第一个
+        for (unsigned lead = LEAD_MIN; lead <= LEAD_MAX; ++lead) {
+            for (unsigned trail = TRAIL_MIN; trail <= TRAIL_MAX; ++trail) {
+                uint16_t unit = decode[(lead - LEAD_MIN) * TRAIL_COUNT + (trail - TRAIL_MIN)];
+                if (unit != 0 && encode[unit] == 0) {
+                    encode[unit] = static_cast<uint16_t>((lead << 8) | trail);
+                }
+            }
+        }
+    }
+};
+
+// 编码方向的映射表首次使用时构建，之后只读
+static const GbkTable& gbkTable() {
+    static const GbkTable table;
+    return table;
+}
+
+// GBK：ASCII单字节，其余为双字节
+class GbkCodec {
+public:
+    static const size_t UNIT = 1;// 最小编码单元字节数
+    static const bool BIG_ENDIAN_UNIT = false;
+    static const size_t MAX_LENGTH = 2;// 单个字符编码后的最大字节数
+
+    GbkCodec() : table_(gbkTable()) {}
+
+    int decode(const unsigned char* in, size_t len, uint32_t& cp) const {
+        unsigned lead = in[0];
+        if (lead < 0x80) {
+            cp = lead;
+            return 1;
+        }
+        if (lead < GbkTable::LEAD_MIN || lead > GbkTable::LEAD_MAX) {
+            return DECODE_INVALID;
+        }
+        if (len < 2) {
+            return DECODE_INCOMPLETE;
+        }
+        unsigned trail = in[1];
+        if (trail < GbkTable::TRAIL_MIN || trail > GbkTable::TRAIL_MAX) {
+            return DECODE_INVALID;
+        }
+        cp = table_.decode[(lead - GbkTable::LEAD_MIN) * GbkTable::TRAIL_COUNT + (trail - GbkTable::TRAIL_MIN)];
+        return cp != 0 ? 2 : DECODE_INVALID;
+    }
+
+    size_t encode(uint32_t cp, unsigned char* out) const {
+        if (cp < 0x80) {
+            out[0] = static_cast<unsigned char>(cp);
+            return 1;
+        }
+        uint16_t code = cp < 0x10000 ? table_.encode[cp] : 0;
+        if (code == 0) {
+            return 0;
+        }
+        out[0] = static_cast<unsigned char>(code >> 8);
+        out[1] = static_cast<unsigned char>(code);
+        return 2;
+    }
+private:
+    const GbkTable& table_;
+};
+
+// UTF-8：严格解码，拒绝过长编码、代理区和超过U+10FFFF的码点
+class Utf8Codec {
+public:
+    static const size_t UNIT = 1;
+    static const bool BIG_ENDIAN_UNIT = false;
+    static const size_t MAX_LENGTH = 4;
+
+    int decode(const unsigned char* in, size_t len, uint32_t& cp) const {
+        unsigned lead = in[0];
+        if (lead < 0x80) {
+            cp = lead;
+            return 1;
+        }
+        size_t n = 0;
+        unsigned low = 0x80;// 第二字节的取值范围
+        unsigned high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            n = 2;
+            cp = lead & 0x1F;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            n = 3;
+            cp = lead & 0x0F;
+            low = lead == 0xE0 ? 0xA0 : low;
+            high = lead == 0xED ? 0x9F : high;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            n = 4;
+            cp = lead & 0x07;
+            low = lead == 0xF0 ? 0x90 : low;
+            high = lead == 0xF4 ? 0x8F : high;
+        } else {
+            return DECODE_INVALID;
+        }
+        for (size_t i = 1; i < n; ++i) {
+            if (i >= len) {
+                return DECODE_INCOMPLETE;
+            }
+            unsigned c = in[i];
+            if (i == 1 ? (c < low || c > high) : (c & 0xC0) != 0x80) {
+                return DECODE_INVALID;
+            }
+            cp = (cp << 6) | (c & 0x3F);
+        }
+        return static_cast<int>(n);
+    }
+
+    size_t encode(uint32_t cp, unsigned char* out) const {
+        if (cp < 0x80) {
+            out[0] = static_cast<unsigned char>(cp);
+            return 1;
+        }
+        if (cp < 0x800) {
+            out[0] = static_cast<unsigned char>(0xC0 | (cp >> 6));
+            out[1] = static_cast<unsigned char>(0x80 | (cp & 0x3F));
+            return 2;
+        }
+        if (cp < 0x10000) {
+            out[0] = static_cast<unsigned char>(0xE0 | (cp >> 12));
+            out[1] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<unsigned char>(0x80 | (cp & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<unsigned char>(0xF0 | (cp >> 18));
+        out[1] = static_cast<unsigned char>(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = static_cast<unsigned char>(0x80 | (cp & 0x3F));
+        return 4;
+    }
+};
+
+// UTF-16：BMP之外的字符使用代理对，拒绝不成对的代理
+template<bool BigEndian>
+class Utf16Codec {
+public:
+    static const size_t UNIT = 2;
+    static const bool BIG_ENDIAN_UNIT = BigEndian;
+    static const size_t MAX_LENGTH = 4;
+
+    int decode(const unsigned char* in, size_t len, uint32_t& cp) const {
+        if (len < 2) {
+            return DECODE_INCOMPLETE;
+        }
+        uint32_t unit = readUnit(in);
+        if (unit < 0xD800 || unit > 0xDFFF) {
+            cp = unit;
+            return 2;
+        }
+        if (unit > 0xDBFF) {
+            return DECODE_INVALID;// 单独的低位代理
+        }
+        if (len < 4) {
+            return DECODE_INCOMPLETE;
+        }
+        uint32_t low = readUnit(in + 2);
+        if (low < 0xDC00 || low > 0xDFFF) {
+            return DECODE_INVALID;
+        }
+        cp = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+        return 4;
+    }
+
+    size_t encode(uint32_t cp, unsigned char* out) const {
+        if (cp < 0x10000) {
+            writeUnit(out, cp);
+            return 2;
+        }
+        cp -= 0x10000;
+        writeUnit(out, 0xD800 + (cp >> 10));
+        writeUnit(out + 2, 0xDC00 + (cp & 0x3FF));
+        return 4;
+    }
+private:
+    static uint32_t readUnit(const unsigned char* in) {
+        return BigEndian ? (in[0] << 8) | in[1] : in[0] | (in[1] << 8);
+    }
+
+    static void writeUnit(unsigned char* out, uint32_t unit) {
+        out[BigEndian ? 0 : 1] = static_cast<unsigned char>(unit >> 8);
+        out[BigEndian ? 1 : 0] = static_cast<unsigned char>(unit);
+    }
+};
+
+// 当前位置是否为ASCII字符
+template<class Decoder>
+static inline bool startsWithAscii(const unsigned char* in, size_t len) {
+    if (Decoder::UNIT == 1) {
+        return in[0] < 0x80;
+    }
+    return len >= 2 && in[Decoder::BIG_ENDIAN_UNIT ? 0 : 1] == 0 && in[Decoder::BIG_ENDIAN_UNIT ? 1 : 0] < 0x80;
+}
+
+// 批量复制开头连续的ASCII字符，返回字符数
+template<class Decoder, class Encoder>
+static inline size_t copyAscii(const char* in, size_t len, char* out, size_t outSize) {
+    if (Decoder::UNIT == 1 && Encoder::UNIT == 1) {
+        size_t n = MStringSimd::asciiLength(in, len < outSize ? len : outSize);
+        memcpy(out, in, n);
+        return n;
+    }
+    if (Decoder::UNIT == 1) {
+        size_t n = MStringSimd::asciiLength(in, len < outSize / 2 ? len : outSize / 2);
+        MStringSimd::widenAscii(out, in, n, Encoder::BIG_ENDIAN_UNIT);
+        return n;
+    }
+    if (Encoder::UNIT == 1) {
+        return MStringSimd::narrowAscii(out, in, len / 2 < outSize ? len / 2 : outSize, Decoder::BIG_ENDIAN_UNIT);
+    }
+    return 0;// UTF-16之间逐个转换
+}
+
+// 逐字符解码再编码，遇到ASCII字符时批量复制
+template<class Decoder, class Encoder>
+static MStringConvertResult convertImpl(const char* input, size_t len, char* output, size_t outSize, bool last) {
+    const Decoder decoder;
+    const Encoder encoder;
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(input);
+    unsigned char* out = reinterpret_cast<unsigned char*>(output);
+    size_t read = 0;
+    size_t written = 0;
+    MStringConvertError error = MStringConvertError::CONVERT_OK;
+    while (read < len) {
+        if (startsWithAscii<Decoder>(in + read, len - read)) {
+            size_t n = copyAscii<Decoder, Encoder>(input + read, len - read, output + written, outSize - written);
+            read += n * Decoder::UNIT;
+            written += n * Encoder::UNIT;
+            if (read == len) {
+                break;
+            }
+        }
+        uint32_t cp = 0;
+        int n = decoder.decode(in + read, len - read, cp);
+        if (n <= 0) {
+            if (n == DECODE_INVALID) {
+                error = MStringConvertError::CONVERT_INVALID;
+            } else if (last) {
+                error = MStringConvertError::CONVERT_INCOMPLETE;
+            }
+            break;
+        }
+
+        // 剩余空间足够时直接写入，否则先写入临时缓冲区再判断
+        unsigned char buffer[Encoder::MAX_LENGTH];
+        unsigned char* dst = outSize - written >= Encoder::MAX_LENGTH ? out + written : buffer;
+        size_t m = encoder.encode(cp, dst);
+        if (m == 0) {
+            error = MStringConvertError::CONVERT_UNMAPPABLE;
+            break;
+        }
+        if (dst == buffer) {
+            if (m > outSize - written) {
+                error = MStringConvertError::CONVERT_OUTPUT_FULL;
+                break;
+            }
+            memcpy(out + written, buffer, m);
+        }
+        read += n;
+        written += m;
+    }
+    MStringConvertResult result = { error, read, written };
+    return result;
+}
+
+// 按目标编码选择转换函数
+template<class Decoder>
+static MStringConverter::ConvertFunc selectEncoder(StringEncoding to) {
+    switch (to) {
+    case StringEncoding_ANSI:
+        return convertImpl<Decoder, GbkCodec>;
+    case StringEncoding_UTF8:
+    case StringEncoding_UTF8_BOM:
+        return convertImpl<Decoder, Utf8Codec>;
+    case StringEncoding_UTF16_LE:
+        return convertImpl<Decoder, Utf16Codec<false> >;
+    case StringEncoding_UTF16_BE:
+        return convertImpl<Decoder, Utf16Codec<true> >;
+    default:
+        return nullptr;
+    }
+}
+
+// 按源编码和目标编码选择转换函数，不支持时返回nullptr
+static MStringConverter::ConvertFunc selectConverter(StringEncoding from, StringEncoding to) {
+    switch (from) {
+    case StringEncoding_ANSI:
+        return selectEncoder<GbkCodec>(to);
+    case StringEncoding_UTF8:
+    case StringEncoding_UTF8_BOM:
+        return selectEncoder<Utf8Codec>(to);
+    case StringEncoding_UTF16_LE:
+        return selectEncoder<Utf16Codec<false> >(to);
+    case StringEncoding_UTF16_BE:
+        return selectEncoder<Utf16Codec<true> >(to);
+    default:
+        return nullptr;
+    }
+}
+
+MStringConverter::MStringConverter(StringEncoding from, StringEncoding to)
+    : func_(selectConverter(from, to)), pendingLen_(0), position_(0) {
+}
+
+// 转换下一块输入
+MStringConvertResult MStringConverter::update(const char* input, size_t len, char* output, size_t outSize) {
+    MStringConvertResult result = { MStringConvertError::CONVERT_UNSUPPORTED, 0, 0 };
+    if (func_ == nullptr) {
+        return result;
+    }
+
+    // 上一块末尾未完成的序列与本块开头拼接后转换
+    size_t skip = 0;// 拼接部分消耗的本块字节数
+    if (pendingLen_ > 0) {
+        size_t take = len < sizeof(pending_) - pendingLen_ ? len : sizeof(pending_) - pendingLen_;
+        memcpy(pending_ + pendingLen_, input, take);
+        result = func_(reinterpret_cast<const char*>(pending_), pendingLen_ + take, output, outSize, false);
+        if (result.read < pendingLen_) {
+            if (result.error == MStringConvertError::CONVERT_OK) {
+                pendingLen_ += take;// 本块太短，序列仍未完成
+                result.read = take;
+            } else {
+                result.read = 0;// 出错的序列始于上一块
+            }
+            return result;
+        }
+        skip = result.read - pendingLen_;
+        position_ += result.read;
+        pendingLen_ = 0;
+        if (result.error != MStringConvertError::CONVERT_OK) {
+            result.read = skip;
+            return result;
+        }
+    }
+
+    MStringConvertResult rest = func_(input + skip, len - skip, output + result.written, outSize - result.written, false);
+    position_ += rest.read;
+    rest.read += skip;
+    rest.written += result.written;
+    if (rest.error == MStringConvertError::CONVERT_OK && rest.read < len) {
+        pendingLen_ = len - rest.read;// 末尾未完成的序列，最多3字节
+        memcpy(pending_, input + rest.read, pendingLen_);
+        rest.read = len;
+    }
+    return rest;
+}
+
+// 输入结束
+MStringConvertResult MStringConverter::finish() const {
+    MStringConvertResult result = { MStringConvertError::CONVERT_OK, 0, 0 };
+    if (func_ == nullptr) {
+        result.error = MStringConvertError::CONVERT_UNSUPPORTED;
+    } else if (pendingLen_ > 0) {
+        result.error = MStringConvertError::CONVERT_INCOMPLETE;
+    }
+    return result;
+}
+
+// 重新开始
+void MStringConverter::reset() {
+    pendingLen_ = 0;
+    position_ = 0;
+}
+
+// 一次性转换
+MStringConvertResult MStringConverter::convert(StringEncoding from, StringEncoding to, const char* input, size_t len,
+                                               char* output, size_t outSize) {
+    ConvertFunc func = selectConverter(from, to);
+    if (func == nullptr) {
+        MStringConvertResult result = { MStringConvertError::CONVERT_UNSUPPORTED, 0, 0 };
+        return result;
+    }
+    return func(input, len, output, outSize, true);
+}
+
+// 转换后的最大长度
+size_t MStringConverter::maxOutputLength(StringEncoding from, StringEncoding to, size_t len) {
+    bool fromUtf16 = from == StringEncoding_UTF16_LE || from == StringEncoding_UTF16_BE;
+    if (to == StringEncoding_UTF16_LE || to == StringEncoding_UTF16_BE) {
+        return fromUtf16 ? len : len * 2;// 单字节ASCII扩展为2字节
+    }
+    if (to == StringEncoding_UTF8 || to == StringEncoding_UTF8_BOM) {
+        if (fromUtf16) {
+            return len / 2 * 3;// BMP字符2字节 -> 3字节
+        }
+        return from == StringEncoding_ANSI ? len / 2 * 3 + len % 2 : len;// GBK双字节 -> 3字节
+    }
+    return len;// GBK每个字符不超过源编码的长度
+}
@@ -0,0 +1,138 @@
+#ifndef MSTRINGENCODING_H
+#define MSTRINGENCODING_H
+
+#include <cstddef>
+
+enum StringEncoding {
+    StringEncoding_Empty = -2,
+    StringEncoding_Unknown = -1,
+    StringEncoding_ANSI = 0,
+    StringEncoding_UTF8,
+    StringEncoding_UTF8_BOM,
+    StringEncoding_UTF16_LE,
+    StringEncoding_UTF16_BE,
+};
+
+// UTF-8增量校验：数据可以分块传入，多字节序列可以跨越分块边界
+//   MStringUtf8Validator validator;
+//   while (读取chunk) validator.update(chunk, len);
+//   bool ok = validator.finish();
+class MStringUtf8Validator {
+public:
+    MStringUtf8Validator();
+
+    // 校验下一块数据，目前为止出现过非法序列时返回false
+    bool update(const char* data, size_t len);
+
+    // 输入结束：全部合法且末尾没有未完成的序列时返回true
+    bool finish() const {
+        return valid_ && pendingLen_ == 0;
+    }
+
+    // 目前为止是否合法（末尾未完成的序列不算错误）
+    bool isValid() const {
+        return valid_;
+    }
+
+    // 重新开始
+    void reset();
+private:
+    unsigned char pending_[4];// 上一块末尾未完成的序列
+    size_t pendingLen_;
+    bool valid_;
+};
+
+// 编码检测：数据可以分块传入，不要求以'\0'结尾，可以检测不带BOM的UTF-16
+// 判定顺序：BOM -> UTF-16（0字节集中在奇数或偶数偏移上） -> UTF-8（严格校验且含非ASCII字节） -> ANSI
+class MStringEncodingDetector {
+public:
+    MStringEncodingDetector();
+
+    // 传入下一块数据
+    void update(const char* data, size_t len);
+
+    // 根据目前为止传入的数据给出检测结果
+    StringEncoding result() const;
+
+    // 重新开始
+    void reset();
+
+    // 一次性检测整块数据
+    static StringEncoding detect(const char* data, size_t len);
+private:
+    // 只统计开头这么多字节中0字节的分布
+    static const size_t UTF16_SAMPLE_SIZE = 64 * 1024;
+
+    // 根据开头的字节判断BOM，没有BOM返回StringEncoding_Unknown
+    StringEncoding bomEncoding() const;
+
+    unsigned char head_[3];// 开头的字节
+    size_t headLen_;
+    size_t total_;// 已传入的字节数
+    size_t zeroCount_[2];// 偶数/奇数偏移上的0字节数
+    bool nonAscii_;// 是否出现过非ASCII字节
+    MStringUtf8Validator utf8_;
+};
+
+// 编码转换错误
+enum class MStringConvertError {
+    CONVERT_OK,// 转换成功
+    CONVERT_INVALID,// 输入中有非法序列
+    CONVERT_INCOMPLETE,// 输入在多字节序列中间结束
+    CONVERT_UNMAPPABLE,// 目标编码无法表示该字符
+    CONVERT_OUTPUT_FULL,// 输出缓冲区不足
+    CONVERT_UNSUPPORTED// 不支持的编码
+};
+
+// 编码转换结果
+struct MStringConvertResult {
+    MStringConvertError error;
+    size_t read;// 已消耗的输入字节数，出错时即为出错序列在输入中的位置
+    size_t written;// 已写入的输出字节数
+};
+
+// 编码转换：GBK（StringEncoding_ANSI）、UTF-8、UTF-16 LE/BE之间互转，写入调用方提供的缓冲区
+// GBK映射表内置（MStringGbkTable.h），不依赖系统的代码页或iconv
+// BOM按普通字符处理，StringEncoding_UTF8_BOM与StringEncoding_UTF8相同
+// 分块输入时，块末尾未完成的序列保存在内部，与下一块拼接后转换：
+//   MStringConverter converter(StringEncoding_ANSI, StringEncoding_UTF8);
+//   while (读取chunk) {
+//       MStringConvertResult r = converter.update(chunk, len, out, size);
+//       输出缓冲区不足时（CONVERT_OUTPUT_FULL）写出out后从chunk + r.read继续
+//   }
+//   converter.finish();
+class MStringConverter {
+public:
+    MStringConverter(StringEncoding from, StringEncoding to);
+
+    // 转换下一块输入
+    MStringConvertResult update(const char* input, size_t len, char* output, size_t outSize);
+
+    // 输入结束：内部还有未完成的序列时返回CONVERT_INCOMPLETE
+    MStringConvertResult finish() const;
+
+    // 已转换的输入总字节数，出错时即为出错序列在整个输入流中的位置
+    size_t position() const {
+        return position_;
+    }
+
+    // 重新开始
+    void reset();
+
+    // 一次性转换，输入末尾不完整的序列报告为CONVERT_INCOMPLETE
+    static MStringConvertResult convert(StringEncoding from, StringEncoding to, const char* input, size_t len,
+                                        char* output, size_t outSize);
+
+    // len字节输入转换后的最大长度，用于预分配输出缓冲区
+    static size_t maxOutputLength(StringEncoding from, StringEncoding to, size_t len);
+
+    // 转换函数：last为false时末尾未完成的序列不算错误，不消耗
+    typedef MStringConvertResult (*ConvertFunc)(const char* input, size_t len, char* output, size_t outSize, bool last);
+private:
+    ConvertFunc func_;
+    unsigned char pending_[8];// 上一块末尾未完成的序列（最多3字节），以及拼接的下一块开头
+    size_t pendingLen_;
+    size_t position_;
+};
+
+#endif //MSTRINGENCODING_H
@@ -0,0 +1,367 @@
+#include "MStringFormat.h"
+#include "MStringBuilder.h"
+#include <cstdio>
+
+const size_t MStringFormat::MAX_WIDTH;
+
+// 格式化输出目标
+class MStringFormatSink {
+public:
+    virtual ~MStringFormatSink() {}
+
+    // 追加数据
+    virtual void append(const char* s, size_t len) = 0;
+
+    // 追加count个相同字符
+    void appendFill(char c, size_t count) {
+        char block[32];
+        memset(block, c, count < sizeof(block) ? count : sizeof(block));
+        while (count > 0) {
+            size_t n = count < sizeof(block) ? count : sizeof(block);
+            append(block, n);
+            count -= n;
+        }
+    }
+};
+
+// 输出到构建器
+class MStringBuilderSink : public MStringFormatSink {
+private:
+    MStringBuilder& builder_;
+public:
+    explicit MStringBuilderSink(MStringBuilder& builder) : builder_(builder) {}
+
+    void append(const char* s, size_t len) override {
+        builder_.append(s, len);
+    }
+};
+
+// 输出到字符串
+class MStringAppendSink : public MStringFormatSink {
+private:
+    MString& str_;
+public:
+    explicit MStringAppendSink(MString& str) : str_(str) {}
+
+    void append(const char* s, size_t len) override {
+        str_.append(s, len);
+    }
+};
+
+// 输出到固定大小的缓冲区，超出部分只计数
+class MStringArraySink : public MStringFormatSink {
+private:
+    char* buffer_;// 缓冲区
+    size_t capacity_;// 可写入的最大长度（不含'\0'）
+    size_t written_;// 已写入长度
+    size_t total_;// 完整结果长度
+public:
+    MStringArraySink(char* buffer, size_t size)
+        : buffer_(buffer), capacity_(size > 0 ? size - 1 : 0), written_(0), total_(0) {}
+
+    void append(const char* s, size_t len) override {
+        size_t n = capacity_ - written_;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(buffer_ + written_, s, n);
+        written_ += n;
+        total_ += len;
+    }
+
+    size_t written() const {
+        return written_;
+    }
+
+    size_t total() const {
+        return total_;
+    }
+};
+
+// 格式串或字符串参数是否引用了[begin, end]内的数据
+bool MStringFormat::refersTo(const char* begin, const char* end, MStringView fmt, const MStringFormatValue* values, size_t count) {
+    auto overlaps = [begin, end](const char* data, size_t len) {
+        return len > 0 && data <= end && data + len > begin;
+    };
+    if (overlaps(fmt.data(), fmt.length())) {
+        return true;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i].kind_ == MStringFormatValue::Kind::VALUE_STRING && overlaps(values[i].string_.data, values[i].string_.len)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 输出到构建器
+MStringFormatResult MStringFormat::formatValues(MStringBuilder& buffer, MStringView fmt, const MStringFormatValue* values, size_t count) {
+    size_t oldLen = buffer.length();
+    MStringView target = buffer.view();
+    if (refersTo(target.begin(), target.end(), fmt, values, count)) {
+        // 参数引用了构建器自身的内容：先格式化到临时构建器，再一次性追加
+        MStringBuilder temp;
+        MStringBuilderSink sink(temp);
+        formatValues(sink, fmt, values, count);
+        buffer.append(temp.view());
+    } else {
+        MStringBuilderSink sink(buffer);
+        formatValues(sink, fmt, values, count);
+    }
+    MStringFormatResult result = { buffer.length() - oldLen, false };
+    return result;
+}
+
+// 输出到固定大小的缓冲区
+MStringFormatResult MStringFormat::formatValues(char* buffer, size_t size, MStringView fmt, const MStringFormatValue* values, size_t count) {
+    MStringArraySink sink(buffer, size);
+    formatValues(sink, fmt, values, count);
+    if (size > 0) {
+        buffer[sink.written()] = '\0';
+    }
+    MStringFormatResult result = { sink.total(), sink.written() < sink.total() };
+    return result;
+}
+
+// 输出到字符串
+MStringFormatResult MStringFormat::formatValues(MString& str, MStringView fmt, const MStringFormatValue* values, size_t count) {
+    size_t oldLen = str.length();
+    if (refersTo(str.getData(), str.getData() + oldLen, fmt, values, count)) {
+        // 参数引用了目标字符串自身（如 t.appendFormat("{}", t)）：先格式化到临时构建器，再一次性追加
+        MStringBuilder temp;
+        MStringBuilderSink sink(temp);
+        formatValues(sink, fmt, values, count);
+        str.append(temp.view());
+    } else {
+        MStringAppendSink sink(str);
+        formatValues(sink, fmt, values, count);
+    }
+    MStringFormatResult result = { str.length() - oldLen, false };
+    return result;
+}
+
+// 解析格式串并输出
+void MStringFormat::formatValues(MStringFormatSink& sink, MStringView fmt, const MStringFormatValue* values, size_t count) {
+    const char* pos = fmt.begin();
+    const char* end = fmt.end();
+    const char* literal = pos;// 尚未输出的字面量起始位置
+    size_t index = 0;// 下一个参数
+    while (pos < end) {
+        const char* brace = pos;
+        while (brace < end && *brace != '{' && *brace != '}') {
+            brace++;
+        }
+        if (brace + 1 >= end) {
+            break;
+        }
+        // 转义的花括号
+        if (brace[1] == brace[0]) {
+            sink.append(literal, brace + 1 - literal);
+            pos = literal = brace + 2;
+            continue;
+        }
+        if (*brace == '}') {
+            pos = brace + 1;
+            continue;
+        }
+
+        // 占位符："{}"或"{:格式}"
+        const char* close = brace + 1;
+        Spec spec = { ' ', 0, false, 0, -1, 0 };
+        if (*close == ':') {
+            const char* specBegin = close + 1;
+            close = static_cast<const char*>(memchr(specBegin, '}', end - specBegin));
+            if (close == nullptr || !parseSpec(MStringView(specBegin, close - specBegin), spec)) {
+                pos = brace + 1;// 不是有效的占位符，按字面量输出
+                continue;
+            }
+        } else if (*close != '}') {
+            pos = brace + 1;
+            continue;
+        }
+        if (index >= count) {
+            pos = close + 1;// 参数不足，占位符按字面量输出
+            continue;
+        }
+        sink.append(literal, brace - literal);
+        formatValue(sink, values[index++], spec);
+        pos = literal = close + 1;
+    }
+    sink.append(literal, end - literal);
+}
+
+// 解析格式说明
+bool MStringFormat::parseSpec(MStringView text, Spec& spec) {
+    const char* pos = text.begin();
+    const char* end = text.end();
+    auto isAlign = [](char c) {
+        return c == '<' || c == '>' || c == '^';
+    };
+
+    // [[填充字符]对齐]
+    if (end - pos >= 2 && isAlign(pos[1])) {
+        spec.fill = pos[0];
+        spec.align = pos[1];
+        pos += 2;
+    } else if (pos < end && isAlign(*pos)) {
+        spec.align = *pos++;
+    }
+
+    // [0][宽度]
+    if (pos < end && *pos == '0') {
+        spec.zeroPad = true;
+        pos++;
+    }
+    for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+        if (spec.width < MAX_WIDTH) {
+            spec.width = spec.width * 10 + (*pos - '0');
+        }
+    }
+    if (spec.width > MAX_WIDTH) {
+        spec.width = MAX_WIDTH;
+    }
+
+    // [.精度]
+    if (pos < end && *pos == '.') {
+        const char* digits = ++pos;
+        int precision = 0;
+        for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+            if (precision < 100) {
+                precision = precision * 10 + (*pos - '0');
+            }
+        }
+        if (pos == digits) {
+            return false;
+        }
+        spec.precision = precision;
+    }
+
+    // [类型]
+    if (pos < end) {
+        spec.type = *pos++;
+    }
+    return pos == end;
+}
+
+// 按宽度和对齐方式输出
+void MStringFormat::writePadded(MStringFormatSink& sink, const Spec& spec, char defaultAlign, MStringView prefix, MStringView body) {
+    size_t len = prefix.length() + body.length();
+    size_t padding = spec.width > len ? spec.width - len : 0;
+    if (padding == 0) {
+        sink.append(prefix.data(), prefix.length());
+        sink.append(body.data(), body.length());
+        return;
+    }
+
+    // 补0：符号之后、数字之前
+    if (spec.zeroPad && spec.align == 0) {
+        sink.append(prefix.data(), prefix.length());
+        sink.appendFill('0', padding);
+        sink.append(body.data(), body.length());
+        return;
+    }
+
+    char align = spec.align != 0 ? spec.align : defaultAlign;
+    size_t before = align == '<' ? 0 : (align == '^' ? padding / 2 : padding);
+    sink.appendFill(spec.fill, before);
+    sink.append(prefix.data(), prefix.length());
+    sink.append(body.data(), body.length());
+    sink.appendFill(spec.fill, padding - before);
+}
+
+// 无符号整数按十六/八/二进制输出，返回写入长度（从bufferEnd向前写）
+static size_t integerToChars(char* bufferEnd, unsigned long long value, char type) {
+    unsigned base = 16;
+    const char* digits = type == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+    if (type == 'o') {
+        base = 8;
+    } else if (type == 'b') {
+        base = 2;
+    }
+    char* pos = bufferEnd;
+    do {
+        *--pos = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return bufferEnd - pos;
+}
+
+// 按格式说明输出单个参数
+void MStringFormat::formatValue(MStringFormatSink& sink, const MStringFormatValue& value, const Spec& spec) {
+    char buffer[512];// 整数二进制最长64位；浮点数精度不超过99位，定点格式整数部分不超过309位
+    switch (value.kind_) {
+    case MStringFormatValue::Kind::VALUE_STRING: {
+        size_t len = value.string_.len;
+        if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < len) {
+            len = spec.precision;
+        }
+        writePadded(sink, spec, '<', MStringView(), MStringView(value.string_.data, len));
+        return;
+    }
+    case MStringFormatValue::Kind::VALUE_CHAR:
+        if (spec.type == 0 || spec.type == 'c') {
+            writePadded(sink, spec, '<', MStringView(), MStringView(&value.char_, 1));
+            return;
+        }
+        {
+            MStringFormatValue number(static_cast<int>(value.char_));
+            formatValue(sink, number, spec);
+        }
+        return;
+    case MStringFormatValue::Kind::VALUE_BOOL:
+        writePadded(sink, spec, '<', MStringView(), value.bool_ ? "1" : "0");// 与std::ostream默认格式一致
+        return;
+    case MStringFormatValue::Kind::VALUE_SIGNED:
+    case MStringFormatValue::Kind::VALUE_UNSIGNED: {
+        bool negative = value.kind_ == MStringFormatValue::Kind::VALUE_SIGNED && value.signed_ < 0;
+        unsigned long long magnitude = value.kind_ == MStringFormatValue::Kind::VALUE_UNSIGNED ? value.unsigned_
+                                     : negative ? 0ULL - static_cast<unsigned long long>(value.signed_)
+                                     : static_cast<unsigned long long>(value.signed_);
+        if (spec.type == 'c') {
+            char c = static_cast<char>(magnitude);
+            writePadded(sink, spec, '<', MStringView(), MStringView(&c, 1));
+            return;
+        }
+        MStringView digits;
+        if (spec.type == 'x' || spec.type == 'X' || spec.type == 'o' || spec.type == 'b') {
+            char* bufferEnd = buffer + sizeof(buffer);
+            size_t len = integerToChars(bufferEnd, magnitude, spec.type);
+            digits = MStringView(bufferEnd - len, len);
+        } else {
+            digits = MStringView(buffer, MStringNumber::toChars(buffer, magnitude));
+        }
+        writePadded(sink, spec, '>', negative ? "-" : "", digits);
+        return;
+    }
+    case MStringFormatValue::Kind::VALUE_DOUBLE: {
+        double number = value.double_;
+        size_t len = 0;
+        if (spec.precision < 0 && spec.type != 'f' && spec.type != 'e' && spec.type != 'g') {
+            len = MStringNumber::toChars(buffer, number);// 默认：能精确还原的最短表示
+        } else {
+            char format[] = "%.*g";
+            if (spec.type == 'f' || spec.type == 'e') {
+                format[3] = spec.type;
+            }
+            int written = snprintf(buffer, sizeof(buffer), format, spec.precision < 0 ? 6 : spec.precision, number);
+            len = written > 0 ? (static_cast<size_t>(written) < sizeof(buffer) ? written : sizeof(buffer) - 1) : 0;
+        }
+        // 符号作为前缀，补0时填在符号之后
+        size_t sign = (len > 0 && (buffer[0] == '-' || buffer[0] == '+')) ? 1 : 0;
+        writePadded(sink, spec, '>', MStringView(buffer, sign), MStringView(buffer + sign, len - sign));
+        return;
+    }
+    case MStringFormatValue::Kind::VALUE_OTHER:
+    default: {
+        std::ostringstream oss;
+        value.other_.write(oss, value.other_.object);
+        const std::string str = oss.str();
+        size_t len = str.size();
+        if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < len) {
+            len = spec.precision;
+        }
+        writePadded(sink, spec, '<', MStringView(), MStringView(str.data(), len));
+        return;
+    }
+    }
+}
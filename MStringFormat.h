@@ -0,0 +1,346 @@
+#ifndef MSTRINGFORMAT_H
+#define MSTRINGFORMAT_H
+
+#include <string>
+#include <sstream>
+#include <type_traits>
+#include "MString.h"
+
+class MStringBuilder;
+class MStringFormatSink;
+
+// 编译期解析的格式化（只支持"{}"）：格式串必须是字符串字面量，编译期确定各"{}"的位置，
+// 占位符数量与参数数量不一致时编译失败；先计算结果总长度，只分配一次内存
+//   MString s = MSTRING_FORMAT("{} {}: {}", "Set", "Index", 123);
+// 只能在函数内使用；格式串长度受编译器constexpr递归深度限制（GCC默认512）
+#define MSTRING_FORMAT(fmt, ...) \
+    ([&]() -> MString { \
+        struct MStringFormatLiteral { \
+            static constexpr const char* str() { return fmt; } \
+        }; \
+        return MStringFormat::format<MStringFormatLiteral>(__VA_ARGS__); \
+    }())
+
+// 编译期整数序列（C++11没有std::index_sequence）
+template<size_t... I>
+struct MStringIndexSequence {};
+
+template<size_t N, size_t... I>
+struct MStringMakeIndexSequence : MStringMakeIndexSequence<N - 1, N - 1, I...> {};
+
+template<size_t... I>
+struct MStringMakeIndexSequence<0, I...> {
+    typedef MStringIndexSequence<I...> type;
+};
+
+// 格式化参数：字符串类参数直接引用原数据，数值写入内部缓冲区，其他类型通过operator<<输出
+class MStringFormatArg {
+private:
+    const char* external_;// 引用的外部数据，nullptr表示使用内部缓冲区
+    size_t len_;// 数据长度
+    char buffer_[MStringNumber::MAX_LENGTH];// 数值格式化缓冲区
+    std::string stream_;// 其他类型的输出结果
+
+    template<typename T>
+    struct IsStringLike {
+        static const bool value = std::is_convertible<const T&, MStringView>::value;
+    };
+
+    template<typename T>
+    struct IsInteger {
+        static const bool value = std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value;
+    };
+public:
+    // 字符串：MString、std::string、const char*、字符数组、视图
+    template<typename T>
+    MStringFormatArg(const T& value, typename std::enable_if<IsStringLike<T>::value>::type* = nullptr) {
+        MStringView view(value);
+        external_ = view.data();
+        len_ = view.length();
+    }
+
+    // 单个字符
+    MStringFormatArg(char c) : external_(nullptr), len_(1) {
+        buffer_[0] = c;
+    }
+
+    // 布尔值（与std::ostream默认格式一致，输出1/0）
+    MStringFormatArg(bool b) : external_(b ? "1" : "0"), len_(1) {}
+
+    // 整数
+    template<typename T>
+    MStringFormatArg(const T& value, typename std::enable_if<IsInteger<T>::value>::type* = nullptr) : external_(nullptr) {
+        len_ = MStringNumber::toChars(buffer_, value);
+    }
+
+    // 浮点数
+    template<typename T>
+    MStringFormatArg(const T& value, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr)
+        : external_(nullptr), len_(MStringNumber::toChars(buffer_, value)) {}
+
+    // 其他类型：通过operator<<输出
+    template<typename T>
+    MStringFormatArg(const T& value, typename std::enable_if<!IsStringLike<T>::value && !std::is_arithmetic<T>::value>::type* = nullptr)
+        : external_(nullptr) {
+        std::ostringstream oss;
+        oss << value;
+        stream_ = oss.str();
+        len_ = stream_.size();
+    }
+
+    // 数据起始位置
+    const char* data() const {
+        return external_ ? external_ : (stream_.empty() ? buffer_ : stream_.data());
+    }
+
+    // 数据长度
+    size_t length() const {
+        return len_;
+    }
+};
+
+// 运行期格式化参数：保存参数的类型和值（字符串只保存视图），格式化时再按格式说明输出
+class MStringFormatValue {
+public:
+    enum class Kind {// 参数类型
+        VALUE_STRING,// 字符串
+        VALUE_CHAR,// 单个字符
+        VALUE_BOOL,// 布尔值
+        VALUE_SIGNED,// 有符号整数
+        VALUE_UNSIGNED,// 无符号整数
+        VALUE_DOUBLE,// 浮点数
+        VALUE_OTHER// 其他类型，通过operator<<输出
+    };
+
+    // 字符串：MString、std::string、const char*、字符数组、视图
+    template<typename T>
+    MStringFormatValue(const T& value, typename std::enable_if<std::is_convertible<const T&, MStringView>::value>::type* = nullptr)
+        : kind_(Kind::VALUE_STRING) {
+        MStringView view(value);
+        string_.data = view.data();
+        string_.len = view.length();
+    }
+
+    // 单个字符
+    MStringFormatValue(char c) : kind_(Kind::VALUE_CHAR) {
+        char_ = c;
+    }
+
+    // 布尔值
+    MStringFormatValue(bool b) : kind_(Kind::VALUE_BOOL) {
+        bool_ = b;
+    }
+
+    // 有符号整数
+    template<typename T>
+    MStringFormatValue(const T& value, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value &&
+                                                               !std::is_same<T, char>::value>::type* = nullptr)
+        : kind_(Kind::VALUE_SIGNED) {
+        signed_ = value;
+    }
+
+    // 无符号整数
+    template<typename T>
+    MStringFormatValue(const T& value, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                                                               !std::is_same<T, char>::value && !std::is_same<T, bool>::value>::type* = nullptr)
+        : kind_(Kind::VALUE_UNSIGNED) {
+        unsigned_ = value;
+    }
+
+    // 浮点数
+    template<typename T>
+    MStringFormatValue(const T& value, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr)
+        : kind_(Kind::VALUE_DOUBLE) {
+        double_ = static_cast<double>(value);
+    }
+
+    // 其他类型
+    template<typename T>
+    MStringFormatValue(const T& value, typename std::enable_if<!std::is_convertible<const T&, MStringView>::value &&
+                                                               !std::is_arithmetic<T>::value>::type* = nullptr)
+        : kind_(Kind::VALUE_OTHER) {
+        other_.object = &value;
+        other_.write = &writeObject<T>;
+    }
+private:
+    friend class MStringFormat;
+
+    typedef void (*WriteFunc)(std::ostream& os, const void* object);
+
+    struct StringValue {
+        const char* data;
+        size_t len;
+    };
+
+    struct OtherValue {
+        const void* object;
+        WriteFunc write;
+    };
+
+    Kind kind_;// 参数类型
+    union {
+        StringValue string_;
+        char char_;
+        bool bool_;
+        long long signed_;
+        unsigned long long unsigned_;
+        double double_;
+        OtherValue other_;
+    };
+
+    template<typename T>
+    static void writeObject(std::ostream& os, const void* object) {
+        os << *static_cast<const T*>(object);
+    }
+};
+
+// 格式化到调用方缓冲区的结果
+struct MStringFormatResult {
+    size_t length;// 完整格式化结果的长度（与snprintf返回值含义相同）
+    bool truncated;// 固定大小缓冲区容纳不下时为true
+};
+
+// 格式化实现
+class MStringFormat {
+public:
+    // 格式串长度
+    static constexpr size_t literalLength(const char* s, size_t i = 0) {
+        return s[i] == '\0' ? i : literalLength(s, i + 1);
+    }
+
+    // 占位符"{}"数量
+    static constexpr size_t countPlaceholders(const char* s, size_t i = 0) {
+        return s[i] == '\0' ? 0
+             : (s[i] == '{' && s[i + 1] == '}') ? 1 + countPlaceholders(s, i + 2)
+             : countPlaceholders(s, i + 1);
+    }
+
+    // 第n个占位符的位置，不存在时返回格式串长度
+    static constexpr size_t placeholderPos(const char* s, size_t n, size_t i = 0) {
+        return s[i] == '\0' ? i
+             : (s[i] == '{' && s[i + 1] == '}') ? (n == 0 ? i : placeholderPos(s, n - 1, i + 2))
+             : placeholderPos(s, n, i + 1);
+    }
+
+    // 格式化：Fmt提供 static constexpr const char* str()，一般通过 MSTRING_FORMAT 使用
+    template<typename Fmt, typename... Args>
+    static MString format(const Args&... args) {
+        static_assert(countPlaceholders(Fmt::str()) == sizeof...(Args),
+                      "MSTRING_FORMAT: the number of {} placeholders does not match the number of arguments");
+        return formatImpl<Fmt>(typename MStringMakeIndexSequence<sizeof...(Args)>::type(), args...);
+    }
+
+    // 运行期格式化，追加到构建器（缓冲区容量足够时不分配内存）
+    // 占位符："{}"或"{:[[填充字符]对齐][0][宽度][.精度][类型]}"，"{{"/"}}"输出花括号
+    //   对齐：'<'左对齐 '>'右对齐 '^'居中，默认数值右对齐、其他左对齐；'0'表示数值在符号后补0
+    //   宽度：最大为MAX_WIDTH，超出时按MAX_WIDTH处理
+    //   精度：浮点数为小数位数（类型g为有效数字位数），字符串为最大输出长度
+    //   类型：整数 d/x/X/o/b，浮点数 f/e/g，字符 c（整数按字符输出）
+    // 参数少于占位符时原样输出多余的占位符，多余的参数忽略
+    template<typename... Args>
+    static MStringFormatResult formatTo(MStringBuilder& buffer, MStringView fmt, const Args&... args) {
+        const MStringFormatValue values[] = { MStringFormatValue(args)..., MStringFormatValue("") };
+        return formatValues(buffer, fmt, values, sizeof...(Args));
+    }
+
+    // 运行期格式化，写入固定大小的字符数组（总是以'\0'结尾），容纳不下时截断
+    template<size_t N, typename... Args>
+    static MStringFormatResult formatTo(char (&buffer)[N], MStringView fmt, const Args&... args) {
+        return formatTo(buffer, N, fmt, args...);
+    }
+
+    // 运行期格式化，写入大小为size的缓冲区（size大于0时总是以'\0'结尾），容纳不下时截断
+    template<typename... Args>
+    static MStringFormatResult formatTo(char* buffer, size_t size, MStringView fmt, const Args&... args) {
+        const MStringFormatValue values[] = { MStringFormatValue(args)..., MStringFormatValue("") };
+        return formatValues(buffer, size, fmt, values, sizeof...(Args));
+    }
+
+    // 运行期格式化，追加到字符串
+    template<typename... Args>
+    static MStringFormatResult formatTo(MString& str, MStringView fmt, const Args&... args) {
+        const MStringFormatValue values[] = { MStringFormatValue(args)..., MStringFormatValue("") };
+        return formatValues(str, fmt, values, sizeof...(Args));
+    }
+private:
+    MStringFormat();
+
+    // 最大宽度，避免超大的宽度溢出或输出海量填充字符
+    static const size_t MAX_WIDTH = 4096;
+
+    // 格式说明
+    struct Spec {
+        char fill;// 填充字符
+        char align;// 对齐方式：'<' '>' '^'，0表示默认
+        bool zeroPad;// 数值在符号后补0
+        size_t width;// 最小宽度
+        int precision;// 精度，-1表示未指定
+        char type;// 类型，0表示默认
+    };
+
+    // 各类输出目标
+    static MStringFormatResult formatValues(MStringBuilder& buffer, MStringView fmt, const MStringFormatValue* values, size_t count);
+    static MStringFormatResult formatValues(char* buffer, size_t size, MStringView fmt, const MStringFormatValue* values, size_t count);
+    static MStringFormatResult formatValues(MString& str, MStringView fmt, const MStringFormatValue* values, size_t count);
+
+    // 解析格式串并输出
+    static void formatValues(MStringFormatSink& sink, MStringView fmt, const MStringFormatValue* values, size_t count);
+
+    // 格式串或字符串参数是否引用了[begin, end)内的数据（直接追加到该缓冲区时，扩容会释放它们所在的内存）
+    static bool refersTo(const char* begin, const char* end, MStringView fmt, const MStringFormatValue* values, size_t count);
+
+    // 解析格式说明（不含冒号和右花括号），格式无效返回false
+    static bool parseSpec(MStringView text, Spec& spec);
+
+    // 按格式说明输出单个参数
+    static void formatValue(MStringFormatSink& sink, const MStringFormatValue& value, const Spec& spec);
+
+    // 按宽度和对齐方式输出（body为主体，prefix为符号等前缀，补0时填在前缀之后）
+    static void writePadded(MStringFormatSink& sink, const Spec& spec, char defaultAlign, MStringView prefix, MStringView body);
+
+    template<typename Fmt, size_t... I, typename... Args>
+    static MString formatImpl(MStringIndexSequence<I...>, const Args&... args) {
+        const size_t count = sizeof...(Args);
+        const char* fmt = Fmt::str();
+
+        // 各占位符的位置均为编译期常量，末尾哨兵为格式串长度
+        static const size_t positions[] = { placeholderPos(Fmt::str(), I)..., literalLength(Fmt::str()) };
+        const MStringFormatArg pieces[] = { MStringFormatArg(args)..., MStringFormatArg("") };
+
+        size_t total = literalLength(Fmt::str()) - 2 * count;
+        for (size_t i = 0; i < count; ++i) {
+            total += pieces[i].length();
+        }
+
+        // 一次分配，依次写入字面量片段和参数
+        MString result;
+        char* out = result.initLength(total);
+        size_t segment = 0;
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(out, fmt + segment, positions[i] - segment);
+            out += positions[i] - segment;
+            std::memcpy(out, pieces[i].data(), pieces[i].length());
+            out += pieces[i].length();
+            segment = positions[i] + 2;
+        }
+        std::memcpy(out, fmt + segment, positions[count] - segment);
+        return result;
+    }
+};
+
+// 格式化字符串并返回 MString
+template <typename... Args>
+MString MString::format(MStringView fmt, const Args&... args) {
+    MString result;
+    MStringFormat::formatTo(result, fmt, args...);
+    return result;
+}
+
+// 追加格式化结果，复用已有容量
+template <typename... Args>
+MString& MString::appendFormat(MStringView fmt, const Args&... args) {
+    MStringFormat::formatTo(*this, fmt, args...);
+    return *this;
+}
+
+#endif //MSTRINGFORMAT_H
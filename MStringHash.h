@@ -0,0 +1,125 @@
+#ifndef MSTRINGHASH_H
+#define MSTRINGHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "MString.h"
+
+// 字符串哈希：基于wyhash，每轮处理48字节，短字符串只需一两次64位乘法
+class MStringHash {
+public:
+    static uint64_t hash(const void* data, size_t len, uint64_t seed = 0);
+
+    static size_t hash(MStringView str) {
+        return static_cast<size_t>(hash(str.data(), str.length()));
+    }
+private:
+    MStringHash();
+};
+
+// 缓存哈希值的哈希表键：构造时计算一次哈希值，重复查找时不再重新计算
+// ref()创建引用外部数据的临时键，不复制内容，用于以const char*/视图查找而不构造MString：
+//   std::unordered_map<MStringKey, int> map;
+//   map.find(MStringKey::ref("shenzhen"));
+// 临时键只能在所引用的数据有效期间使用；拷贝或移动临时键得到的都是持有内容的键，可以安全地插入容器
+class MStringKey {
+public:
+    MStringKey(MStringView str) : str_(str) {
+        init(MStringHash::hash(str));
+    }
+
+    MStringKey(const char* str) : str_(str) {
+        init(MStringHash::hash(str_.view()));
+    }
+
+    MStringKey(MString&& str) : str_(std::move(str)) {
+        init(MStringHash::hash(str_.view()));
+    }
+
+    MStringKey(const MStringKey& other) : str_(other.view()) {
+        init(other.hash_);
+    }
+
+    MStringKey(MStringKey&& other) {
+        if (other.isRef()) {
+            str_ = MString(other.view());
+            init(other.hash_);
+        } else {
+            str_ = std::move(other.str_);
+            init(other.hash_);
+            other.init(MStringHash::hash(MStringView()));
+        }
+    }
+
+    MStringKey& operator=(MStringKey other) {
+        str_ = other.isRef() ? MString(other.view()) : std::move(other.str_);// 参数可能直接由ref()的结果初始化
+        init(other.hash_);
+        return *this;
+    }
+
+    // 引用外部数据的临时键
+    static MStringKey ref(MStringView str) {
+        return MStringKey(str, MStringHash::hash(str));
+    }
+
+    MStringView view() const {
+        return MStringView(data_, len_);
+    }
+
+    size_t hash() const {
+        return hash_;
+    }
+
+    friend bool operator==(const MStringKey& a, const MStringKey& b) {
+        return a.hash_ == b.hash_ && a.view() == b.view();
+    }
+
+    friend bool operator!=(const MStringKey& a, const MStringKey& b) {
+        return !(a == b);
+    }
+private:
+    MString str_;// 持有的内容，临时键为空
+    const char* data_;// 持有内容时指向str_
+    size_t len_;
+    size_t hash_;
+
+    // 临时键
+    MStringKey(MStringView str, size_t hash) : data_(str.data()), len_(str.length()), hash_(hash) {}
+
+    void init(size_t hash) {
+        data_ = str_.getData();
+        len_ = str_.length();
+        hash_ = hash;
+    }
+
+    bool isRef() const {
+        return data_ != str_.getData();
+    }
+};
+
+namespace std {
+template<>
+struct hash<MStringView> {
+    size_t operator()(MStringView str) const {
+        return MStringHash::hash(str);
+    }
+};
+
+template<>
+struct hash<MString> {
+    size_t operator()(const MString& str) const {
+        return MStringHash::hash(str.view());
+    }
+};
+
+// 直接使用缓存的哈希值
+template<>
+struct hash<MStringKey> {
+    size_t operator()(const MStringKey& key) const {
+        return key.hash();
+    }
+};
+}
+
+#endif //MSTRINGHASH_H
@@ -0,0 +1,105 @@
+#include "MStringIntern.h"
+#include "MStringHash.h"
+#include <cstring>
+
+const size_t MStringInternPool::SHARD_COUNT;
+
+// 分片初始桶数
+static const size_t INITIAL_BUCKETS = 64;
+
+MStringInternPool::Shard::Shard() : buckets(new Entry*[INITIAL_BUCKETS]()), bucketCount(INITIAL_BUCKETS), size(0) {
+}
+
+MStringInternPool::Shard::~Shard() {
+    delete[] buckets;// 条目由arena整体回收
+}
+
+MStringInternPool::MStringInternPool() {
+}
+
+MStringInternPool::~MStringInternPool() {
+}
+
+// 字符串哈希值
+size_t MStringInternPool::hashOf(MStringView str) {
+    return MStringHash::hash(str);
+}
+
+// 哈希值所在的分片
+size_t MStringInternPool::shardIndex(size_t hash) {
+    return (hash >> (sizeof(size_t) * 8 - 8)) & (SHARD_COUNT - 1);
+}
+
+// 在分片中查找，先比较哈希值再比较内容
+const MStringAtom::Entry* MStringInternPool::findEntry(const Shard& shard, MStringView str, size_t hash) {
+    for (const Entry* entry = shard.buckets[hash & (shard.bucketCount - 1)]; entry != nullptr; entry = entry->next) {
+        if (entry->hash == hash && entry->len == str.length() &&
+            memcmp(entry + 1, str.data(), str.length()) == 0) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+// 桶数翻倍
+void MStringInternPool::rehash(Shard& shard) {
+    size_t count = shard.bucketCount * 2;
+    Entry** buckets = new Entry*[count]();
+    for (size_t i = 0; i < shard.bucketCount; ++i) {
+        Entry* entry = shard.buckets[i];
+        while (entry != nullptr) {
+            Entry* next = entry->next;
+            Entry*& head = buckets[entry->hash & (count - 1)];
+            entry->next = head;
+            head = entry;
+            entry = next;
+        }
+    }
+    delete[] shard.buckets;
+    shard.buckets = buckets;
+    shard.bucketCount = count;
+}
+
+// 驻留字符串
+MStringAtom MStringInternPool::intern(MStringView str) {
+    size_t hash = hashOf(str);
+    Shard& shard = shards_[shardIndex(hash)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const Entry* found = findEntry(shard, str, hash);
+    if (found != nullptr) {
+        return MStringAtom(found);
+    }
+
+    Entry* entry = static_cast<Entry*>(shard.arena.allocate(sizeof(Entry) + str.length() + 1));
+    char* data = reinterpret_cast<char*>(entry + 1);
+    memcpy(data, str.data(), str.length());
+    data[str.length()] = '\0';
+    entry->hash = hash;
+    entry->len = str.length();
+    if (shard.size >= shard.bucketCount) {
+        rehash(shard);// 负载因子不超过1
+    }
+    Entry*& head = shard.buckets[hash & (shard.bucketCount - 1)];
+    entry->next = head;
+    head = entry;
+    shard.size++;
+    return MStringAtom(entry);
+}
+
+// 查找已驻留的字符串
+MStringAtom MStringInternPool::find(MStringView str) const {
+    size_t hash = hashOf(str);
+    const Shard& shard = shards_[shardIndex(hash)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return MStringAtom(findEntry(shard, str, hash));
+}
+
+// 已驻留的字符串数
+size_t MStringInternPool::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].size;
+    }
+    return total;
+}
@@ -0,0 +1,127 @@
+#ifndef MSTRINGINTERN_H
+#define MSTRINGINTERN_H
+
+#include <cstddef>
+#include <mutex>
+#include <functional>
+#include "MStringView.h"
+#include "MStringAllocator.h"
+
+// 驻留字符串句柄：指向池中唯一的不可变条目，大小与指针相同
+// 同一个池返回的句柄相等当且仅当内容相等，比较只需比较指针，哈希值在驻留时计算并缓存
+// 句柄在所属的池析构前有效；默认构造的句柄为空，不等于任何驻留的字符串（包括空字符串）
+class MStringAtom {
+public:
+    MStringAtom() : entry_(nullptr) {}
+
+    // 是否为空句柄
+    bool isNull() const {
+        return entry_ == nullptr;
+    }
+
+    const char* getData() const {
+        return entry_ != nullptr ? reinterpret_cast<const char*>(entry_ + 1) : "";
+    }
+
+    size_t length() const {
+        return entry_ != nullptr ? entry_->len : 0;
+    }
+
+    // 缓存的哈希值，空句柄为0
+    size_t hash() const {
+        return entry_ != nullptr ? entry_->hash : 0;
+    }
+
+    MStringView view() const {
+        return MStringView(getData(), length());
+    }
+
+    operator MStringView() const {
+        return view();
+    }
+
+    friend bool operator==(MStringAtom a, MStringAtom b) {
+        return a.entry_ == b.entry_;
+    }
+
+    friend bool operator!=(MStringAtom a, MStringAtom b) {
+        return a.entry_ != b.entry_;
+    }
+private:
+    // 池中的条目，字符串内容（含结尾'\0'）紧随其后
+    struct Entry {
+        Entry* next;// 同一哈希桶中的下一个条目
+        size_t hash;
+        size_t len;
+    };
+
+    const Entry* entry_;
+
+    explicit MStringAtom(const Entry* entry) : entry_(entry) {}
+
+    friend class MStringInternPool;
+};
+
+namespace std {
+// 直接使用缓存的哈希值
+template<>
+struct hash<MStringAtom> {
+    size_t operator()(MStringAtom atom) const {
+        return atom.hash();
+    }
+};
+}
+
+// 线程安全的字符串驻留池：相同内容只保存一份，返回MStringAtom句柄
+// 按哈希值分片，每个分片有独立的锁、哈希表和单调分配器，不同分片上的驻留互不阻塞
+// 条目只增不删，随池一起析构
+class MStringInternPool {
+public:
+    static const size_t SHARD_COUNT = 16;// 分片数，为2的幂
+
+    MStringInternPool();
+    ~MStringInternPool();
+
+    // 驻留字符串：已存在时返回已有的句柄，否则复制内容并插入
+    MStringAtom intern(MStringView str);
+
+    // 查找已驻留的字符串，不存在时返回空句柄
+    MStringAtom find(MStringView str) const;
+
+    // 已驻留的字符串数
+    size_t size() const;
+private:
+    typedef MStringAtom::Entry Entry;
+
+    // 各分片按缓存行（64字节）对齐，不同线程操作相邻分片的锁和计数时不会伪共享
+    // 注意：C++17之前 new MStringInternPool 不保证超过alignof(std::max_align_t)的对齐，此时只保证各分片占用整数个缓存行
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        Entry** buckets;// 桶数为2的幂
+        size_t bucketCount;
+        size_t size;
+        MStringArena arena;// 条目内存
+
+        Shard();
+        ~Shard();
+    };
+
+    Shard shards_[SHARD_COUNT];
+
+    // 字符串哈希值
+    static size_t hashOf(MStringView str);
+
+    // 哈希值所在的分片：使用高位，桶索引使用低位
+    static size_t shardIndex(size_t hash);
+
+    // 在分片中查找，调用方持有分片的锁
+    static const Entry* findEntry(const Shard& shard, MStringView str, size_t hash);
+
+    // 桶数翻倍，调用方持有分片的锁
+    static void rehash(Shard& shard);
+
+    MStringInternPool(const MStringInternPool&);
+    MStringInternPool& operator=(const MStringInternPool&);
+};
+
+#endif //MSTRINGINTERN_H
@@ -0,0 +1,199 @@
+#include "MStringMappedFile.h"
+#include <utility>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+const size_t MStringMappedFile::DEFAULT_CHUNK_SIZE;
+
+MStringMappedFile::MStringMappedFile() : data_(""), len_(0), open_(false), access_(Access::ACCESS_NORMAL) {
+#ifdef _WIN32
+    file_ = INVALID_HANDLE_VALUE;
+    mapping_ = nullptr;
+#endif
+}
+
+MStringMappedFile::MStringMappedFile(const char* path, Access access) : MStringMappedFile() {
+    open(path, access);
+}
+
+MStringMappedFile::MStringMappedFile(MStringMappedFile&& other) : MStringMappedFile() {
+    *this = std::move(other);
+}
+
+MStringMappedFile& MStringMappedFile::operator=(MStringMappedFile&& other) {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        len_ = other.len_;
+        open_ = other.open_;
+        access_ = other.access_;
+#ifdef _WIN32
+        file_ = other.file_;
+        mapping_ = other.mapping_;
+        other.file_ = INVALID_HANDLE_VALUE;
+        other.mapping_ = nullptr;
+#endif
+        other.data_ = "";
+        other.len_ = 0;
+        other.open_ = false;
+    }
+    return *this;
+}
+
+MStringMappedFile::~MStringMappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+// 打开并映射文件：允许其他进程继续写入（如正在写的日志文件）
+bool MStringMappedFile::open(const char* path, Access access) {
+    close();
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (access == Access::ACCESS_SEQUENTIAL) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (access == Access::ACCESS_RANDOM) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<unsigned long long>(size.QuadPart) > static_cast<size_t>(-1)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (data == nullptr) {
+            if (mapping != nullptr) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            return false;
+        }
+        mapping_ = mapping;
+        data_ = static_cast<const char*>(data);
+        len_ = static_cast<size_t>(size.QuadPart);
+    }
+    file_ = file;
+    open_ = true;
+    access_ = access;
+    return true;
+}
+
+// 解除映射并关闭文件
+void MStringMappedFile::close() {
+    if (len_ > 0) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+    }
+    file_ = INVALID_HANDLE_VALUE;
+    mapping_ = nullptr;
+    data_ = "";
+    len_ = 0;
+    open_ = false;
+}
+
+// Windows下访问提示已在打开文件时给出
+void MStringMappedFile::willNeed(size_t, size_t) const {
+}
+
+void MStringMappedFile::dontNeed(size_t, size_t) const {
+}
+#else
+// 打开并映射文件：映射建立后即可关闭文件描述符
+bool MStringMappedFile::open(const char* path, Access access) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<unsigned long long>(st.st_size) > static_cast<size_t>(-1)) {
+        ::close(fd);
+        return false;
+    }
+    size_t len = static_cast<size_t>(st.st_size);
+    if (len > 0) {
+        void* data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        if (access != Access::ACCESS_NORMAL) {
+            madvise(data, len, access == Access::ACCESS_SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+        }
+        data_ = static_cast<const char*>(data);
+        len_ = len;
+    }
+    ::close(fd);
+    open_ = true;
+    access_ = access;
+    return true;
+}
+
+// 解除映射
+void MStringMappedFile::close() {
+    if (len_ > 0) {
+        munmap(const_cast<char*>(data_), len_);
+    }
+    data_ = "";
+    len_ = 0;
+    open_ = false;
+}
+
+// 对[offset, offset + len)所在的页面给出访问提示，起始地址按页对齐
+static void adviseRange(const char* data, size_t fileLen, size_t offset, size_t len, int advice) {
+    if (offset >= fileLen || len == 0) {
+        return;
+    }
+    if (len > fileLen - offset) {
+        len = fileLen - offset;
+    }
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t aligned = offset & ~(pageSize - 1);
+    madvise(const_cast<char*>(data) + aligned, len + (offset - aligned), advice);
+}
+
+// 提示即将访问
+void MStringMappedFile::willNeed(size_t offset, size_t len) const {
+    adviseRange(data_, len_, offset, len, MADV_WILLNEED);
+}
+
+// 提示暂时不再访问：只读私有映射的页面回收后再次访问时从文件重新读取
+void MStringMappedFile::dontNeed(size_t offset, size_t len) const {
+    adviseRange(data_, len_, offset, len, MADV_DONTNEED);
+}
+#endif
+
+// 进入pos所在的块
+const char* MStringMappedFile::enterChunk(const char* pos, size_t chunkSize, const char*& released) const {
+    if (chunkSize == 0) {
+        return data_ + len_;
+    }
+    size_t chunkStart = static_cast<size_t>(pos - data_) / chunkSize * chunkSize;
+    willNeed(chunkStart, 2 * chunkSize);
+    if (access_ == Access::ACCESS_SEQUENTIAL && chunkStart >= chunkSize) {
+        size_t releaseEnd = chunkStart - chunkSize;// 保留上一块，跨块的行和刚处理过的行仍在内存中
+        size_t releaseStart = static_cast<size_t>(released - data_);
+        if (releaseEnd > releaseStart) {
+            dontNeed(releaseStart, releaseEnd - releaseStart);
+            released = data_ + releaseEnd;
+        }
+    }
+    size_t chunkEnd = chunkStart + chunkSize;
+    return data_ + (chunkEnd < len_ ? chunkEnd : len_);
+}
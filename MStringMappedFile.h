@@ -0,0 +1,173 @@
+#ifndef MSTRINGMAPPEDFILE_H
+#define MSTRINGMAPPEDFILE_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include "MStringView.h"
+
+// 只读内存映射文件：文件内容以MStringView的形式直接使用find/split等接口，不复制到堆内存
+// 文件内容的视图在close或析构前有效；映射期间文件被截断时访问超出部分的行为未定义
+//   MStringMappedFile file("app.log");
+//   for (MStringView line : file.lines()) { if (line.find("ERROR") >= 0) ... }
+class MStringMappedFile {
+public:
+    // 访问模式提示（madvise），Windows下通过打开文件时的标志提示
+    enum class Access {
+        ACCESS_NORMAL,
+        ACCESS_SEQUENTIAL,// 顺序扫描：内核加大预读，已读页面尽早回收
+        ACCESS_RANDOM// 随机访问：关闭预读
+    };
+
+    // 按块遍历的默认块大小
+    static const size_t DEFAULT_CHUNK_SIZE = 16 * 1024 * 1024;
+
+    // 按行遍历：每行不含结尾的"\n"或"\r\n"，文件末尾没有换行符的最后一行同样返回
+    // 文件按chunkSize划分为块，进入新块时预读该块和下一块；顺序访问模式下同时回收上一块之前已扫描的部分，
+    // 扫描大文件时常驻内存保持在几个块以内。被回收的页面再次访问时从文件重新读取，此前得到的行视图依然有效
+    class Lines {
+    public:
+        // 前向迭代器
+        class Iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef MStringView value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const MStringView* pointer;
+            typedef MStringView reference;
+
+            Iterator() : file_(nullptr), pos_(nullptr), lineEnd_(nullptr), chunkEnd_(nullptr), released_(nullptr), chunkSize_(0) {}
+
+            MStringView operator*() const {
+                const char* end = lineEnd_;
+                if (end > pos_ && end[-1] == '\r') {
+                    --end;
+                }
+                return MStringView(pos_, end - pos_);
+            }
+
+            Iterator& operator++() {
+                const char* fileEnd = file_->data() + file_->length();
+                pos_ = lineEnd_ < fileEnd ? lineEnd_ + 1 : fileEnd;
+                findLineEnd();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator& a, const Iterator& b) {
+                return a.pos_ == b.pos_;
+            }
+
+            friend bool operator!=(const Iterator& a, const Iterator& b) {
+                return a.pos_ != b.pos_;
+            }
+        private:
+            Iterator(const MStringMappedFile* file, const char* pos, size_t chunkSize)
+                : file_(file), pos_(pos), lineEnd_(nullptr), chunkEnd_(file->data()), released_(file->data()), chunkSize_(chunkSize) {
+                findLineEnd();
+            }
+
+            // 查找当前行的结尾，跨入新块时更新访问提示
+            void findLineEnd() {
+                const char* fileEnd = file_->data() + file_->length();
+                if (pos_ >= chunkEnd_ && pos_ < fileEnd) {
+                    chunkEnd_ = file_->enterChunk(pos_, chunkSize_, released_);
+                }
+                const void* newline = memchr(pos_, '\n', fileEnd - pos_);
+                lineEnd_ = newline != nullptr ? static_cast<const char*>(newline) : fileEnd;
+            }
+
+            friend class Lines;
+
+            const MStringMappedFile* file_;
+            const char* pos_;// 当前行的起始位置，遍历结束时为文件末尾
+            const char* lineEnd_;// 当前行的换行符位置，最后一行没有换行符时为文件末尾
+            const char* chunkEnd_;// 当前块的结尾
+            const char* released_;// 此位置之前的页面已提示回收
+            size_t chunkSize_;
+        };
+
+        Iterator begin() const {
+            return Iterator(file_, file_->data(), chunkSize_);
+        }
+
+        Iterator end() const {
+            return Iterator(file_, file_->data() + file_->length(), chunkSize_);
+        }
+    private:
+        Lines(const MStringMappedFile* file, size_t chunkSize) : file_(file), chunkSize_(chunkSize) {}
+
+        friend class MStringMappedFile;
+
+        const MStringMappedFile* file_;
+        size_t chunkSize_;
+    };
+
+    MStringMappedFile();
+
+    // 打开并映射文件，失败时isOpen()为false
+    explicit MStringMappedFile(const char* path, Access access = Access::ACCESS_SEQUENTIAL);
+
+    MStringMappedFile(MStringMappedFile&& other);
+    MStringMappedFile& operator=(MStringMappedFile&& other);
+    ~MStringMappedFile();
+
+    // 打开并映射文件（先关闭已打开的文件），成功返回true
+    bool open(const char* path, Access access = Access::ACCESS_SEQUENTIAL);
+
+    // 解除映射并关闭文件
+    void close();
+
+    bool isOpen() const {
+        return open_;
+    }
+
+    const char* data() const {
+        return data_;
+    }
+
+    size_t length() const {
+        return len_;
+    }
+
+    MStringView view() const {
+        return MStringView(data_, len_);
+    }
+
+    operator MStringView() const {
+        return view();
+    }
+
+    // 提示即将访问[offset, offset + len)，内核提前读入
+    void willNeed(size_t offset, size_t len) const;
+
+    // 提示[offset, offset + len)暂时不再访问，内核可以回收这些页面
+    void dontNeed(size_t offset, size_t len) const;
+
+    // 按行遍历，每chunkSize字节为一块更新访问提示
+    Lines lines(size_t chunkSize = DEFAULT_CHUNK_SIZE) const {
+        return Lines(this, chunkSize);
+    }
+private:
+    const char* data_;// 映射地址，空文件或未打开时指向""
+    size_t len_;
+    bool open_;
+    Access access_;
+#ifdef _WIN32
+    void* file_;// 文件句柄
+    void* mapping_;// 文件映射句柄
+#endif
+
+    // 进入pos所在的块：预读该块和下一块，顺序访问时回收[released, 上一块起始)并更新released，返回该块的结尾
+    const char* enterChunk(const char* pos, size_t chunkSize, const char*& released) const;
+
+    MStringMappedFile(const MStringMappedFile&);
+    MStringMappedFile& operator=(const MStringMappedFile&);
+};
+
+#endif //MSTRINGMAPPEDFILE_H
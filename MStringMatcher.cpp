@@ -0,0 +1,190 @@
+#include "MStringMatcher.h"
+#include "MStringBuilder.h"
+#include <algorithm>
+
+// 构造函数
+MStringMatcher::MStringMatcher(std::initializer_list<MStringView> patterns) {
+    for (const auto& pattern : patterns) {
+        addPattern(pattern);
+    }
+    build();
+}
+
+// 添加模式串
+void MStringMatcher::addPattern(MStringView pattern) {
+    patterns_.push_back(MString(pattern));
+    patternLengths_.push_back(pattern.length());
+}
+
+// 构建转移表和输出
+void MStringMatcher::build() {
+    // 字节等价类：只为模式串中出现过的字节分配独立的类，压缩转移表的列数
+    memset(byteClass_, 0, sizeof(byteClass_));
+    classCount_ = 1;
+    for (const auto& pattern : patterns_) {
+        for (size_t i = 0; i < pattern.length(); ++i) {
+            unsigned char byte = static_cast<unsigned char>(pattern.getData()[i]);
+            if (byteClass_[byte] == 0) {
+                byteClass_[byte] = static_cast<unsigned short>(classCount_++);
+            }
+        }
+    }
+
+    // 构建字典树
+    const size_t classCount = classCount_;
+    transitions_.assign(classCount, -1);
+    std::vector<std::vector<int>> nodeOutputs(1);
+    for (size_t id = 0; id < patterns_.size(); ++id) {
+        const MString& pattern = patterns_[id];
+        if (pattern.isEmpty()) {
+            continue;
+        }
+        int state = 0;
+        for (size_t i = 0; i < pattern.length(); ++i) {
+            size_t index = state * classCount + byteClass_[static_cast<unsigned char>(pattern.getData()[i])];
+            if (transitions_[index] == -1) {
+                transitions_[index] = static_cast<int>(nodeOutputs.size());
+                transitions_.resize(transitions_.size() + classCount, -1);
+                nodeOutputs.push_back(std::vector<int>());
+            }
+            state = transitions_[index];
+        }
+        nodeOutputs[state].push_back(static_cast<int>(id));
+    }
+
+    // 广度优先计算失败链接，并将缺失的转移补全为确定性自动机
+    const size_t stateCount = nodeOutputs.size();
+    fail_.assign(stateCount, 0);
+    outputLink_.assign(stateCount, -1);
+    std::vector<int> queue;
+    queue.reserve(stateCount);
+    for (size_t c = 0; c < classCount; ++c) {
+        int& child = transitions_[c];
+        if (child == -1) {
+            child = 0;
+        } else {
+            queue.push_back(child);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int state = queue[head];
+        int fail = fail_[state];
+        for (size_t c = 0; c < classCount; ++c) {
+            int& child = transitions_[state * classCount + c];
+            int next = transitions_[fail * classCount + c];
+            if (child == -1) {
+                child = next;
+            } else {
+                fail_[child] = next;
+                outputLink_[child] = nodeOutputs[next].empty() ? outputLink_[next] : next;
+                queue.push_back(child);
+            }
+        }
+    }
+
+    // 输出压缩为CSR格式
+    outputBegin_.assign(stateCount + 1, 0);
+    outputIds_.clear();
+    std::vector<char> hasOutput(stateCount, 0);
+    for (size_t state = 0; state < stateCount; ++state) {
+        outputBegin_[state] = static_cast<int>(outputIds_.size());
+        outputIds_.insert(outputIds_.end(), nodeOutputs[state].begin(), nodeOutputs[state].end());
+        hasOutput[state] = !nodeOutputs[state].empty() || outputLink_[state] != -1;
+    }
+    outputBegin_[stateCount] = static_cast<int>(outputIds_.size());
+
+    // 转移目标预乘列数并在最低位记录是否有输出，匹配循环中省去乘法和输出表查找
+    for (auto& target : transitions_) {
+        target = static_cast<int>((target * classCount) << 1) | hasOutput[target];
+    }
+
+    // 匹配时不再需要模式串内容和失败链接
+    std::vector<MString>().swap(patterns_);
+    std::vector<int>().swap(fail_);
+}
+
+// 是否包含任一模式串
+bool MStringMatcher::containsAny(MStringView text) const {
+    const int* transitions = transitions_.data();
+    size_t row = 0;
+    for (size_t i = 0; i < text.length(); ++i) {
+        int next = transitions[row + byteClass_[static_cast<unsigned char>(text[i])]];
+        row = static_cast<size_t>(next >> 1);
+        if (next & 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 查找第一个匹配（结束位置最靠前，结束位置相同时取最长的模式串），未找到返回false
+bool MStringMatcher::findFirst(MStringView text, Match& match) const {
+    const int* transitions = transitions_.data();
+    const size_t classCount = classCount_;
+    size_t row = 0;
+    for (size_t i = 0; i < text.length(); ++i) {
+        int next = transitions[row + byteClass_[static_cast<unsigned char>(text[i])]];
+        row = static_cast<size_t>(next >> 1);
+        if (next & 1) {
+            forEachOutput(static_cast<int>(row / classCount), i + 1, [&match](const Match& m) {
+                match = m;
+                return false;
+            });
+            return true;
+        }
+    }
+    return false;
+}
+
+// 查找全部匹配（包含相互重叠的匹配），按结束位置排序
+std::vector<MStringMatcher::Match> MStringMatcher::findAll(MStringView text) const {
+    std::vector<Match> matches;
+    const int* transitions = transitions_.data();
+    const size_t classCount = classCount_;
+    size_t row = 0;
+    for (size_t i = 0; i < text.length(); ++i) {
+        int next = transitions[row + byteClass_[static_cast<unsigned char>(text[i])]];
+        row = static_cast<size_t>(next >> 1);
+        if (next & 1) {
+            forEachOutput(static_cast<int>(row / classCount), i + 1, [&matches](const Match& m) {
+                matches.push_back(m);
+                return true;
+            });
+        }
+    }
+    return matches;
+}
+
+// 多模式替换实现
+MString MStringMatcher::replaceAllImpl(MStringView text, const std::vector<MStringView>& replacements) const {
+    std::vector<Match> matches = findAll(text);
+
+    // 最左最长且不重叠，位置和长度都相同（重复的模式串）时编号小的优先
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        if (a.pos != b.pos) {
+            return a.pos < b.pos;
+        }
+        return a.length != b.length ? a.length > b.length : a.patternId < b.patternId;
+    });
+    std::vector<Match> selected;
+    size_t lastEnd = 0;
+    size_t resultLen = text.length();
+    for (const auto& match : matches) {
+        if (match.pos >= lastEnd && match.patternId < replacements.size()) {
+            selected.push_back(match);
+            lastEnd = match.pos + match.length;
+            resultLen = resultLen - match.length + replacements[match.patternId].length();
+        }
+    }
+
+    // 一次分配结果长度，逐段拷贝
+    MStringBuilder builder(resultLen);
+    size_t copied = 0;
+    for (const auto& match : selected) {
+        builder.append(text.data() + copied, match.pos - copied);
+        builder.append(replacements[match.patternId]);
+        copied = match.pos + match.length;
+    }
+    builder.append(text.data() + copied, text.length() - copied);
+    return builder.build();
+}
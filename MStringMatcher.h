@@ -0,0 +1,91 @@
+#ifndef MSTRINGMATCHER_H
+#define MSTRINGMATCHER_H
+
+#include <vector>
+#include <initializer_list>
+#include "MString.h"
+
+// 多模式匹配器（Aho-Corasick）：由模式串列表构建一次，之后对任意文本单次扫描即可匹配全部模式串
+// 状态转移表按字节等价类压缩为连续数组，构建完成后只读，可在多个线程间共享
+class MStringMatcher {
+public:
+    struct Match {// 匹配结果
+        size_t patternId;// 模式串编号（构造时的下标）
+        size_t pos;// 匹配开始位置
+        size_t length;// 匹配长度
+    };
+
+    // 构造函数：模式串可以是 MString、std::string、const char* 或视图，空模式串被忽略
+    template<typename T>
+    explicit MStringMatcher(const std::vector<T>& patterns) {
+        for (const auto& pattern : patterns) {
+            addPattern(MStringView(pattern));
+        }
+        build();
+    }
+
+    // 构造函数
+    MStringMatcher(std::initializer_list<MStringView> patterns);
+
+    // 模式串数量
+    size_t patternCount() const {
+        return patternLengths_.size();
+    }
+
+    // 是否包含任一模式串
+    bool containsAny(MStringView text) const;
+
+    // 查找第一个匹配（结束位置最靠前，结束位置相同时取最长的模式串），未找到返回false
+    bool findFirst(MStringView text, Match& match) const;
+
+    // 查找全部匹配（包含相互重叠的匹配），按结束位置排序
+    std::vector<Match> findAll(MStringView text) const;
+
+    // 多模式替换：从左到右选取最左最长且不重叠的匹配，替换为replacements中对应编号的字符串
+    // 多个模式串相同时编号最小的生效
+    template<typename T>
+    MString replaceAll(MStringView text, const std::vector<T>& replacements) const {
+        std::vector<MStringView> views;
+        views.reserve(replacements.size());
+        for (const auto& replacement : replacements) {
+            views.push_back(MStringView(replacement));
+        }
+        return replaceAllImpl(text, views);
+    }
+private:
+    size_t classCount_;// 字节等价类数量（类0为未出现在任何模式串中的字节）
+    unsigned short byteClass_[256];// 字节 -> 等价类
+    std::vector<int> transitions_;// 状态转移表：transitions_[state * classCount_ + class] = (目标状态 * classCount_) << 1 | 目标状态是否有输出
+    std::vector<int> fail_;// 失败链接（仅构建时使用）
+    std::vector<int> outputLink_;// 沿失败链接最近的有输出状态，-1表示没有
+    std::vector<int> outputBegin_;// 各状态自身输出在outputIds_中的起始下标（CSR，长度为状态数+1）
+    std::vector<int> outputIds_;// 各状态自身匹配的模式串编号
+    std::vector<size_t> patternLengths_;// 各模式串长度
+    std::vector<MString> patterns_;// 模式串（构建完成后释放）
+
+    // 添加模式串
+    void addPattern(MStringView pattern);
+
+    // 构建转移表和输出
+    void build();
+
+    // 多模式替换实现
+    MString replaceAllImpl(MStringView text, const std::vector<MStringView>& replacements) const;
+
+    // 报告某状态上的全部输出，func返回false时停止
+    template<typename Func>
+    bool forEachOutput(int state, size_t end, Func func) const {
+        for (int s = state; s != -1; s = outputLink_[s]) {
+            for (int i = outputBegin_[s]; i < outputBegin_[s + 1]; ++i) {
+                size_t id = outputIds_[i];
+                Match match = { id, end - patternLengths_[id], patternLengths_[id] };
+                if (!func(match)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+#endif //MSTRINGMATCHER_H
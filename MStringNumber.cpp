@@ -0,0 +1,330 @@
+#include "MStringNumber.h"
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+const size_t MStringNumber::MAX_LENGTH;
+
+// 两位数字表："00" "01" ... "99"
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// 可以精确表示为double的10的幂（快速路径使用）
+static const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// 是否为空白字符
+static inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// 去除首尾空白
+static inline void trimSpace(const char*& pos, const char*& end) {
+    while (pos < end && isSpace(*pos)) pos++;
+    while (end > pos && isSpace(*(end - 1))) end--;
+}
+
+// 十进制位数
+static inline size_t digitCount(unsigned long long value) {
+    size_t count = 1;
+    for (;;) {
+        if (value < 10) return count;
+        if (value < 100) return count + 1;
+        if (value < 1000) return count + 2;
+        if (value < 10000) return count + 3;
+        value /= 10000;
+        count += 4;
+    }
+}
+
+// 无符号整数 -> 字符串：每次处理两位数字
+size_t MStringNumber::unsignedToChars(char* out, unsigned long long value) {
+    const size_t len = digitCount(value);
+    char* pos = out + len;
+    while (value >= 100) {
+        const unsigned index = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--pos = DIGIT_PAIRS[index + 1];
+        *--pos = DIGIT_PAIRS[index];
+    }
+    if (value >= 10) {
+        const unsigned index = static_cast<unsigned>(value) * 2;
+        *--pos = DIGIT_PAIRS[index + 1];
+        *--pos = DIGIT_PAIRS[index];
+    } else {
+        *--pos = static_cast<char>('0' + value);
+    }
+    return len;
+}
+
+// 定点快速路径：1e-4 <= |value| < 1e15 时寻找最少的小数位数k，使 m / 10^k 精确还原value（m不超过15位），
+// 结果与"%.15g"一致；不满足条件返回0
+static size_t fixedToChars(char* out, double value) {
+    const double absValue = std::fabs(value);
+    if (!(absValue >= 1e-4 && absValue < 1e15)) {
+        return 0;
+    }
+    for (size_t k = 0; k < sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]); ++k) {
+        const double scaled = absValue * POWERS_OF_TEN[k];
+        if (scaled >= 1e15) {
+            return 0;
+        }
+        const double rounded = std::floor(scaled + 0.5);
+        if (rounded / POWERS_OF_TEN[k] != absValue) {
+            continue;
+        }
+
+        // 写入 m，并在倒数第k位前插入小数点
+        char digits[24];
+        size_t digitLen = MStringNumber::toChars(digits, static_cast<unsigned long long>(rounded));
+        size_t scale = k;
+        while (scale > 0 && digits[digitLen - 1] == '0') {
+            digitLen--;
+            scale--;
+        }
+        char* pos = out;
+        if (value < 0) {
+            *pos++ = '-';
+        }
+        if (scale == 0) {
+            memcpy(pos, digits, digitLen);
+            return pos + digitLen - out;
+        }
+        if (digitLen > scale) {
+            memcpy(pos, digits, digitLen - scale);
+            pos += digitLen - scale;
+            *pos++ = '.';
+            memcpy(pos, digits + digitLen - scale, scale);
+            return pos + scale - out;
+        }
+        *pos++ = '0';
+        *pos++ = '.';
+        memset(pos, '0', scale - digitLen);
+        pos += scale - digitLen;
+        memcpy(pos, digits, digitLen);
+        return pos + digitLen - out;
+    }
+    return 0;
+}
+
+// 当前语言环境（LC_NUMERIC）的小数点，snprintf/strtod按它输出和解析
+static inline char localeDecimalPoint() {
+    const char* point = localeconv()->decimal_point;
+    return point != nullptr && point[0] != '\0' ? point[0] : '.';
+}
+
+// 浮点数 -> 字符串：从15位（float为6位）有效数字开始尝试，直到能精确还原
+// 正规数能用更少位数还原时，%.15g（float为%.6g）去掉末尾的0后即为最短表示；非正规数精度较低，从1位开始尝试
+// 输出中的小数点总为'.'，与当前语言环境无关
+size_t MStringNumber::doubleToChars(char* out, double value, bool isFloat) {
+    if (value == 0) {
+        memcpy(out, std::signbit(value) ? "-0" : "0", 2);
+        return std::signbit(value) ? 2 : 1;
+    }
+    if (!isFloat) {
+        size_t len = fixedToChars(out, value);
+        if (len > 0) {
+            return len;
+        }
+    }
+    const bool subnormal = isFloat ? std::fabs(value) < std::numeric_limits<float>::min()
+                                   : std::fabs(value) < std::numeric_limits<double>::min();
+    const int minPrecision = subnormal ? 1 : (isFloat ? std::numeric_limits<float>::digits10 : std::numeric_limits<double>::digits10);
+    const int maxPrecision = isFloat ? 9 : 17;// max_digits10
+    int len = 0;
+    for (int precision = minPrecision; precision <= maxPrecision; ++precision) {
+        len = snprintf(out, MAX_LENGTH, "%.*g", precision, value);
+        if (len <= 0) {
+            return 0;
+        }
+        if (!std::isfinite(value) || precision == maxPrecision) {
+            break;
+        }
+        double parsed = strtod(out, nullptr);
+        if (isFloat ? static_cast<float>(parsed) == static_cast<float>(value) : parsed == value) {
+            break;
+        }
+    }
+    const char point = localeDecimalPoint();
+    if (point != '.') {
+        char* found = static_cast<char*>(memchr(out, point, len));
+        if (found != nullptr) {
+            *found = '.';
+        }
+    }
+    return static_cast<size_t>(len);
+}
+
+// 解析无符号十进制数字，遇到非数字停止，返回是否溢出
+static inline bool parseDigits(const char*& pos, const char* end, unsigned long long& value) {
+    unsigned long long result = 0;
+    bool overflow = false;
+    for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+        unsigned digit = static_cast<unsigned>(*pos - '0');
+        if (result > (std::numeric_limits<unsigned long long>::max() - digit) / 10) {
+            overflow = true;
+        } else {
+            result = result * 10 + digit;
+        }
+    }
+    value = result;
+    return overflow;
+}
+
+// 字符串 -> 有符号整数
+MStringNumberError MStringNumber::parseSigned(MStringView text, long long& value) {
+    const char* pos = text.begin();
+    const char* end = text.end();
+    trimSpace(pos, end);
+    bool negative = false;
+    if (pos < end && (*pos == '+' || *pos == '-')) {
+        negative = *pos++ == '-';
+    }
+    const char* digits = pos;
+    unsigned long long magnitude = 0;
+    bool overflow = parseDigits(pos, end, magnitude);
+    if (pos == digits || pos != end) {
+        return MStringNumberError::NUMBER_INVALID;
+    }
+    const unsigned long long limit = negative ? 0ULL - static_cast<unsigned long long>(std::numeric_limits<long long>::min())
+                                              : static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+    if (overflow || magnitude > limit) {
+        return MStringNumberError::NUMBER_OUT_OF_RANGE;
+    }
+    value = negative ? static_cast<long long>(0ULL - magnitude) : static_cast<long long>(magnitude);
+    return MStringNumberError::NUMBER_OK;
+}
+
+// 字符串 -> 无符号整数（负数视为超出范围）
+MStringNumberError MStringNumber::parseUnsigned(MStringView text, unsigned long long& value) {
+    const char* pos = text.begin();
+    const char* end = text.end();
+    trimSpace(pos, end);
+    bool negative = false;
+    if (pos < end && (*pos == '+' || *pos == '-')) {
+        negative = *pos++ == '-';
+    }
+    const char* digits = pos;
+    unsigned long long magnitude = 0;
+    bool overflow = parseDigits(pos, end, magnitude);
+    if (pos == digits || pos != end) {
+        return MStringNumberError::NUMBER_INVALID;
+    }
+    if (overflow || (negative && magnitude != 0)) {
+        return MStringNumberError::NUMBER_OUT_OF_RANGE;
+    }
+    value = magnitude;
+    return MStringNumberError::NUMBER_OK;
+}
+
+// 字符串 -> 浮点数：先校验格式，有效数字不超过15位且指数较小时直接计算（结果精确），否则交给strtod
+MStringNumberError MStringNumber::parseDouble(MStringView text, double& value) {
+    const char* pos = text.begin();
+    const char* end = text.end();
+    trimSpace(pos, end);
+    const char* start = pos;
+
+    bool negative = false;
+    if (pos < end && (*pos == '+' || *pos == '-')) {
+        negative = *pos++ == '-';
+    }
+
+    // 尾数：整数部分和小数部分
+    unsigned long long mantissa = 0;
+    int significant = 0;// 已累计的有效数字位数
+    int exponent = 0;// 十进制指数修正
+    size_t digits = 0;
+    for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos, ++digits) {
+        if (significant < 19) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*pos - '0');
+            significant += (mantissa != 0);
+        } else {
+            exponent++;
+        }
+    }
+    if (pos < end && *pos == '.') {
+        for (++pos; pos < end && *pos >= '0' && *pos <= '9'; ++pos, ++digits) {
+            if (significant < 19) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*pos - '0');
+                significant += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+    if (digits == 0) {
+        return MStringNumberError::NUMBER_INVALID;
+    }
+
+    // 指数部分
+    if (pos < end && (*pos == 'e' || *pos == 'E')) {
+        ++pos;
+        bool negativeExp = false;
+        if (pos < end && (*pos == '+' || *pos == '-')) {
+            negativeExp = *pos++ == '-';
+        }
+        const char* expDigits = pos;
+        int exp = 0;
+        for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+            if (exp < 100000) {
+                exp = exp * 10 + (*pos - '0');
+            }
+        }
+        if (pos == expDigits) {
+            return MStringNumberError::NUMBER_INVALID;
+        }
+        exponent += negativeExp ? -exp : exp;
+    }
+    if (pos != end) {
+        return MStringNumberError::NUMBER_INVALID;
+    }
+
+    // 快速路径：尾数和10的幂都能精确表示为double，一次乘除法即为正确舍入的结果
+    if (significant <= 15 && mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+        value = negative ? -result : result;
+        return MStringNumberError::NUMBER_OK;
+    }
+
+    // 一般路径：strtod需要'\0'结尾，且按当前语言环境的小数点解析，拷贝时替换'.'
+    char buffer[64];
+    std::string longText;
+    char* terminated = buffer;
+    const size_t len = end - start;
+    if (len < sizeof(buffer)) {
+        memcpy(buffer, start, len);
+        buffer[len] = '\0';
+    } else {
+        longText.assign(start, len);
+        terminated = &longText[0];
+    }
+    const char point = localeDecimalPoint();
+    if (point != '.') {
+        char* found = static_cast<char*>(memchr(terminated, '.', len));
+        if (found != nullptr) {
+            *found = point;
+        }
+    }
+    errno = 0;
+    double result = strtod(terminated, nullptr);
+    if (errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL)) {
+        return MStringNumberError::NUMBER_OUT_OF_RANGE;
+    }
+    value = result;
+    return MStringNumberError::NUMBER_OK;
+}
@@ -0,0 +1,108 @@
+#ifndef MSTRINGNUMBER_H
+#define MSTRINGNUMBER_H
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include "MStringView.h"
+
+// 数值转换结果
+enum class MStringNumberError {
+    NUMBER_OK,// 转换成功
+    NUMBER_INVALID,// 不是有效的数值格式
+    NUMBER_OUT_OF_RANGE// 超出目标类型的取值范围
+};
+
+// 数值与字符串之间的转换：写入调用方提供的缓冲区，不分配内存、不抛出异常
+// 小数点总为'.'，与当前语言环境（LC_NUMERIC）无关
+class MStringNumber {
+public:
+    // 任意数值格式化结果的最大长度（不含'\0'）
+    static const size_t MAX_LENGTH = 32;
+
+    // 整数 -> 字符串（十进制），out至少容纳MAX_LENGTH字节，返回写入长度
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value, size_t>::type toChars(char* out, T value) {
+        if (isNegative(value, std::is_signed<T>())) {
+            *out = '-';
+            return 1 + unsignedToChars(out + 1, 0ULL - static_cast<unsigned long long>(value));
+        }
+        return unsignedToChars(out, static_cast<unsigned long long>(value));
+    }
+
+    // 浮点数 -> 字符串：能精确还原原值的最短表示（含非正规数），out至少容纳MAX_LENGTH字节，返回写入长度
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, size_t>::type toChars(char* out, T value) {
+        return doubleToChars(out, static_cast<double>(value), std::is_same<T, float>::value);
+    }
+
+    // 字符串 -> 整数：只接受十进制整数，允许首尾空白和正负号
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value, MStringNumberError>::type parse(MStringView text, T& value) {
+        if (std::is_signed<T>::value) {
+            long long result = 0;
+            MStringNumberError error = parseSigned(text, result);
+            if (error == MStringNumberError::NUMBER_OK &&
+                (result < static_cast<long long>(std::numeric_limits<T>::min()) ||
+                 result > static_cast<long long>(std::numeric_limits<T>::max()))) {
+                error = MStringNumberError::NUMBER_OUT_OF_RANGE;
+            }
+            if (error == MStringNumberError::NUMBER_OK) {
+                value = static_cast<T>(result);
+            }
+            return error;
+        }
+        unsigned long long result = 0;
+        MStringNumberError error = parseUnsigned(text, result);
+        if (error == MStringNumberError::NUMBER_OK && result > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+            error = MStringNumberError::NUMBER_OUT_OF_RANGE;
+        }
+        if (error == MStringNumberError::NUMBER_OK) {
+            value = static_cast<T>(result);
+        }
+        return error;
+    }
+
+    // 字符串 -> 浮点数：十进制小数或科学计数法，允许首尾空白和正负号
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, MStringNumberError>::type parse(MStringView text, T& value) {
+        double result = 0;
+        MStringNumberError error = parseDouble(text, result);
+        if (error == MStringNumberError::NUMBER_OK && (result > static_cast<double>(std::numeric_limits<T>::max()) ||
+                                                       result < -static_cast<double>(std::numeric_limits<T>::max()))) {
+            error = MStringNumberError::NUMBER_OUT_OF_RANGE;
+        }
+        if (error == MStringNumberError::NUMBER_OK) {
+            value = static_cast<T>(result);
+        }
+        return error;
+    }
+private:
+    MStringNumber();
+
+    // 是否为负数（无符号类型及bool恒为false）
+    template<typename T>
+    static bool isNegative(T value, std::true_type) {
+        return value < 0;
+    }
+
+    template<typename T>
+    static bool isNegative(T, std::false_type) {
+        return false;
+    }
+
+    // 无符号整数 -> 字符串：每次处理两位数字
+    static size_t unsignedToChars(char* out, unsigned long long value);
+
+    // 浮点数 -> 字符串：从15位（float为6位，非正规数为1位）有效数字开始尝试，直到能精确还原
+    static size_t doubleToChars(char* out, double value, bool isFloat);
+
+    // 字符串 -> 整数
+    static MStringNumberError parseSigned(MStringView text, long long& value);
+    static MStringNumberError parseUnsigned(MStringView text, unsigned long long& value);
+
+    // 字符串 -> 浮点数
+    static MStringNumberError parseDouble(MStringView text, double& value);
+};
+
+#endif //MSTRINGNUMBER_H
@@ -0,0 +1,382 @@
+#include "MStringRope.h"
+#include "MStringSimd.h"
+#include <cstring>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <sys/uio.h>
+#endif
+
+const size_t MStringRope::npos;
+const size_t MStringRope::CHUNK_SIZE;
+
+MStringRope::MStringRope() : tailOffset_(0), tailLen_(0) {
+}
+
+MStringRope::MStringRope(MStringView str) : tailOffset_(0), tailLen_(0) {
+    append(str);
+}
+
+MStringRope::MStringRope(const char* str) : tailOffset_(0), tailLen_(0) {
+    append(MStringView(str));
+}
+
+MStringRope::NodePtr MStringRope::makeLeaf(const std::shared_ptr<Chunk>& chunk, size_t offset, size_t len) {
+    std::shared_ptr<Node> node = std::make_shared<Node>();
+    node->chunk = chunk;
+    node->data = chunk->data.get() + offset;
+    node->length = len;
+    node->height = 0;
+    return node;
+}
+
+MStringRope::NodePtr MStringRope::makeNode(const NodePtr& left, const NodePtr& right) {
+    std::shared_ptr<Node> node = std::make_shared<Node>();
+    node->data = nullptr;
+    node->left = left;
+    node->right = right;
+    node->length = left->length + right->length;
+    node->height = 1 + (left->height > right->height ? left->height : right->height);
+    return node;
+}
+
+// 左旋：右子节点成为新的根
+MStringRope::NodePtr MStringRope::rotateLeft(const NodePtr& node) {
+    const NodePtr& right = node->right;
+    return makeNode(makeNode(node->left, right->left), right->right);
+}
+
+// 右旋：左子节点成为新的根
+MStringRope::NodePtr MStringRope::rotateRight(const NodePtr& node) {
+    const NodePtr& left = node->left;
+    return makeNode(left->left, makeNode(left->right, node->right));
+}
+
+// left比right高2层以上：沿left的右边界下降到高度相近的子树处拼接，回溯时旋转恢复平衡
+MStringRope::NodePtr MStringRope::joinRight(const NodePtr& left, const NodePtr& right) {
+    const NodePtr& outer = left->left;
+    const NodePtr& inner = left->right;
+    if (height(inner) <= height(right) + 1) {
+        NodePtr joined = makeNode(inner, right);
+        if (height(joined) <= height(outer) + 1) {
+            return makeNode(outer, joined);
+        }
+        return rotateLeft(makeNode(outer, rotateRight(joined)));
+    }
+    NodePtr joined = joinRight(inner, right);
+    NodePtr node = makeNode(outer, joined);
+    return height(joined) <= height(outer) + 1 ? node : rotateLeft(node);
+}
+
+// right比left高2层以上：与joinRight对称
+MStringRope::NodePtr MStringRope::joinLeft(const NodePtr& left, const NodePtr& right) {
+    const NodePtr& outer = right->right;
+    const NodePtr& inner = right->left;
+    if (height(inner) <= height(left) + 1) {
+        NodePtr joined = makeNode(left, inner);
+        if (height(joined) <= height(outer) + 1) {
+            return makeNode(joined, outer);
+        }
+        return rotateRight(makeNode(rotateLeft(joined), outer));
+    }
+    NodePtr joined = joinLeft(left, inner);
+    NodePtr node = makeNode(joined, outer);
+    return height(joined) <= height(outer) + 1 ? node : rotateRight(node);
+}
+
+// 拼接两棵平衡树
+MStringRope::NodePtr MStringRope::join(const NodePtr& left, const NodePtr& right) {
+    if (!left || left->length == 0) {
+        return right;
+    }
+    if (!right || right->length == 0) {
+        return left;
+    }
+    if (left->height > right->height + 1) {
+        return joinRight(left, right);
+    }
+    if (right->height > left->height + 1) {
+        return joinLeft(left, right);
+    }
+    return makeNode(left, right);
+}
+
+// 在pos处拆分：叶子拆为共享同一块的两段，内部节点递归拆分后与另一侧子树拼接
+void MStringRope::split(const NodePtr& node, size_t pos, NodePtr& left, NodePtr& right) {
+    if (!node || pos == 0) {
+        left = NodePtr();
+        right = node;
+        return;
+    }
+    if (pos >= node->length) {
+        left = node;
+        right = NodePtr();
+        return;
+    }
+    if (node->height == 0) {
+        size_t offset = node->data - node->chunk->data.get();
+        left = makeLeaf(node->chunk, offset, pos);
+        right = makeLeaf(node->chunk, offset + pos, node->length - pos);
+        return;
+    }
+    if (pos <= node->left->length) {
+        NodePtr rest;
+        split(node->left, pos, left, rest);
+        right = join(rest, node->right);
+    } else {
+        NodePtr rest;
+        split(node->right, pos - node->left->length, rest, right);
+        left = join(node->left, rest);
+    }
+}
+
+// 末尾叶子并入树中，此后的追加继续使用块的剩余空间
+void MStringRope::flushTail() {
+    if (tailLen_ > 0) {
+        root_ = join(root_, makeLeaf(tailChunk_, tailOffset_, tailLen_));
+        tailOffset_ += tailLen_;
+        tailLen_ = 0;
+    }
+}
+
+// 包含末尾叶子的整棵树
+MStringRope::NodePtr MStringRope::whole() const {
+    return tailLen_ > 0 ? join(root_, makeLeaf(tailChunk_, tailOffset_, tailLen_)) : root_;
+}
+
+// 追加内容：末尾块紧接在本叶子之后的空间未被占用时就地写入，否则新建块
+MStringRope& MStringRope::append(MStringView str) {
+    size_t len = str.length();
+    if (len == 0) {
+        return *this;
+    }
+    if (tailChunk_) {
+        size_t end = tailOffset_ + tailLen_;
+        if (len <= tailChunk_->capacity - end && tailChunk_->used.compare_exchange_strong(end, end + len)) {
+            memcpy(tailChunk_->data.get() + end, str.data(), len);
+            tailLen_ += len;
+            return *this;
+        }
+    }
+    flushTail();
+    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(len > CHUNK_SIZE / 2 ? len : CHUNK_SIZE);
+    memcpy(chunk->data.get(), str.data(), len);
+    chunk->used = len;
+    if (len > CHUNK_SIZE / 2) {
+        root_ = join(root_, makeLeaf(chunk, 0, len));// 长内容单独成块，保留原末尾块继续追加
+        return *this;
+    }
+    tailChunk_ = chunk;
+    tailOffset_ = 0;
+    tailLen_ = len;
+    return *this;
+}
+
+// 拼接另一个绳索字符串
+MStringRope& MStringRope::append(const MStringRope& other) {
+    NodePtr tree = other.whole();// other可能就是自身
+    flushTail();
+    root_ = join(root_, tree);
+    return *this;
+}
+
+// 在pos处插入
+MStringRope& MStringRope::insert(size_t pos, const MStringRope& other) {
+    NodePtr tree = other.whole();
+    flushTail();
+    NodePtr left;
+    NodePtr right;
+    split(root_, pos, left, right);
+    root_ = join(join(left, tree), right);
+    return *this;
+}
+
+// 删除从pos开始的n个字符
+MStringRope& MStringRope::erase(size_t pos, size_t n) {
+    flushTail();
+    NodePtr left;
+    NodePtr rest;
+    split(root_, pos, left, rest);
+    NodePtr removed;
+    NodePtr right;
+    split(rest, n, removed, right);
+    root_ = join(left, right);
+    return *this;
+}
+
+// 截取从pos开始的n个字符
+MStringRope MStringRope::substring(size_t pos, size_t n) const {
+    NodePtr left;
+    NodePtr rest;
+    split(whole(), pos, left, rest);
+    MStringRope result;
+    NodePtr right;
+    split(rest, n, result.root_, right);
+    return result;
+}
+
+// 第pos个字符
+char MStringRope::at(size_t pos) const {
+    size_t treeLen = root_ ? root_->length : 0;
+    if (pos >= treeLen) {
+        return tailChunk_->data[tailOffset_ + pos - treeLen];
+    }
+    const Node* node = root_.get();
+    while (node->height > 0) {
+        if (pos < node->left->length) {
+            node = node->left.get();
+        } else {
+            pos -= node->left->length;
+            node = node->right.get();
+        }
+    }
+    return node->data[pos];
+}
+
+// 查找子字符串：块内使用SIMD查找，跨块的匹配在前一部分末尾与当前块开头拼成的窗口中查找
+size_t MStringRope::find(MStringView substr, size_t startPos) const {
+    size_t len = length();
+    if (startPos > len || substr.length() > len - startPos) {
+        return npos;
+    }
+    if (substr.isEmpty()) {
+        return startPos;
+    }
+    size_t keep = substr.length() - 1;// 跨块匹配最多需要前一部分的末尾keep个字符
+    std::vector<char> window;// 当前块之前的末尾字符（最多keep个）
+    size_t pos = 0;// 当前块在整个字符串中的起始位置
+    size_t result = npos;
+    forEachChunk([&](MStringView chunk) {
+        size_t chunkStart = pos;
+        pos += chunk.length();
+        if (pos <= startPos) {
+            return true;
+        }
+        // 跳过startPos之前的部分
+        size_t skip = startPos > chunkStart ? startPos - chunkStart : 0;
+        if (!window.empty()) {
+            // 从前一部分开始、延伸到本块的匹配
+            size_t head = chunk.length() < keep ? chunk.length() : keep;
+            size_t windowLen = window.size();
+            window.insert(window.end(), chunk.data(), chunk.data() + head);
+            const char* match = MStringSimd::find(window.data(), window.size(), substr.data(), substr.length());
+            if (match != nullptr && static_cast<size_t>(match - window.data()) < windowLen) {
+                result = chunkStart - windowLen + (match - window.data());
+                return false;
+            }
+            window.resize(windowLen);
+        }
+        const char* match = MStringSimd::find(chunk.data() + skip, chunk.length() - skip, substr.data(), substr.length());
+        if (match != nullptr) {
+            result = chunkStart + (match - chunk.data());
+            return false;
+        }
+        // 保留末尾keep个字符供下一块使用
+        size_t tail = chunk.length() - skip < keep ? chunk.length() - skip : keep;
+        window.insert(window.end(), chunk.end() - tail, chunk.end());
+        if (window.size() > keep) {
+            window.erase(window.begin(), window.end() - keep);
+        }
+        return true;
+    });
+    return result;
+}
+
+// 复制全部内容
+void MStringRope::copyTo(char* out) const {
+    forEachChunk([&out](MStringView chunk) {
+        memcpy(out, chunk.data(), chunk.length());
+        out += chunk.length();
+        return true;
+    });
+}
+
+// 展开为连续的字符串
+MString MStringRope::flatten() const {
+    MString result;
+    result.reserve(length());
+    forEachChunk([&result](MStringView chunk) {
+        result.append(chunk);
+        return true;
+    });
+    return result;
+}
+
+// 块数
+size_t MStringRope::chunkCount() const {
+    size_t count = 0;
+    forEachChunk([&count](MStringView) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+#ifdef _WIN32
+// 写入文件描述符：逐块写入
+bool MStringRope::writeTo(int fd) const {
+    bool ok = true;
+    forEachChunk([fd, &ok](MStringView chunk) {
+        const char* data = chunk.data();
+        size_t left = chunk.length();
+        while (left > 0) {
+            unsigned n = left < 0x40000000 ? static_cast<unsigned>(left) : 0x40000000;
+            int written = _write(fd, data, n);
+            if (written <= 0) {
+                ok = false;
+                return false;
+            }
+            data += written;
+            left -= written;
+        }
+        return true;
+    });
+    return ok;
+}
+#else
+// 一次writev最多写入的块数
+static const int IOV_BATCH = 64;
+
+// 写入一批块，处理部分写入和信号中断
+static bool writeBatch(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size_t n = static_cast<size_t>(written);
+        while (count > 0 && n >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + n;
+            iov->iov_len -= n;
+        }
+    }
+    return true;
+}
+
+// 写入文件描述符：每IOV_BATCH个块调用一次writev
+bool MStringRope::writeTo(int fd) const {
+    struct iovec iov[IOV_BATCH];
+    int count = 0;
+    bool ok = true;
+    forEachChunk([fd, &iov, &count, &ok](MStringView chunk) {
+        iov[count].iov_base = const_cast<char*>(chunk.data());
+        iov[count].iov_len = chunk.length();
+        if (++count == IOV_BATCH) {
+            ok = writeBatch(fd, iov, count);
+            count = 0;
+        }
+        return ok;
+    });
+    return ok && writeBatch(fd, iov, count);
+}
+#endif
@@ -0,0 +1,159 @@
+#ifndef MSTRINGROPE_H
+#define MSTRINGROPE_H
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include "MString.h"
+
+// 绳索字符串：由不可变的共享块组成的平衡树（AVL），用于拼装很长的文本
+// 拼接、插入、删除、截取的复杂度为O(log n)，不复制已有内容；拷贝只增加引用计数，各副本互不影响
+// 短内容追加到末尾块的剩余空间，不分配树节点；find需要扫描内容，复杂度为O(n)
+// 结果可以一次性展开为连续的MString，或直接通过writev写入文件描述符而不展开
+//   MStringRope report;
+//   for (...) report += line;
+//   report.writeTo(fd);
+class MStringRope {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+    static const size_t CHUNK_SIZE = 4096;// 追加短内容时新建块的容量，超过一半的内容单独成块
+
+    MStringRope();
+    MStringRope(MStringView str);
+    MStringRope(const char* str);
+
+    size_t length() const {
+        return (root_ ? root_->length : 0) + tailLen_;
+    }
+
+    bool isEmpty() const {
+        return length() == 0;
+    }
+
+    // 追加内容
+    MStringRope& append(MStringView str);
+
+    MStringRope& append(const char* str) {
+        return append(MStringView(str));
+    }
+
+    // 拼接另一个绳索字符串（共享其节点）
+    MStringRope& append(const MStringRope& other);
+
+    MStringRope& operator+=(MStringView str) {
+        return append(str);
+    }
+
+    MStringRope& operator+=(const char* str) {
+        return append(MStringView(str));
+    }
+
+    MStringRope& operator+=(const MStringRope& other) {
+        return append(other);
+    }
+
+    friend MStringRope operator+(const MStringRope& a, const MStringRope& b) {
+        MStringRope result(a);
+        result.append(b);
+        return result;
+    }
+
+    // 在pos处插入，pos超过长度时追加到末尾
+    MStringRope& insert(size_t pos, const MStringRope& other);
+
+    // 删除从pos开始的n个字符
+    MStringRope& erase(size_t pos, size_t n = npos);
+
+    // 截取从pos开始的n个字符
+    MStringRope substring(size_t pos, size_t n = npos) const;
+
+    // 第pos个字符，pos必须小于长度
+    char at(size_t pos) const;
+
+    // 查找子字符串（可跨越块边界），返回开始位置，未找到返回npos
+    size_t find(MStringView substr, size_t startPos = 0) const;
+
+    // 展开为连续的字符串，只分配一次内存
+    MString flatten() const;
+
+    // 复制全部内容到out，out至少容纳length()字节
+    void copyTo(char* out) const;
+
+    // 写入文件描述符：POSIX下按块批量writev，Windows下逐块_write；全部写入返回true
+    bool writeTo(int fd) const;
+
+    // 块数
+    size_t chunkCount() const;
+
+    // 按顺序访问每个块，func返回false时停止
+    template<typename Func>
+    void forEachChunk(Func func) const {
+        if (root_ && !visit(root_.get(), func)) {
+            return;
+        }
+        if (tailLen_ > 0) {
+            func(MStringView(tailChunk_->data.get() + tailOffset_, tailLen_));
+        }
+    }
+private:
+    // 块：只追加写入，已被叶子引用的部分不再修改
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+        std::atomic<size_t> used;// 已分配给叶子的长度，追加时通过CAS占用剩余空间
+
+        explicit Chunk(size_t cap) : data(new char[cap]), capacity(cap), used(0) {}
+    };
+
+    struct Node;
+    typedef std::shared_ptr<const Node> NodePtr;
+
+    // 树节点：叶子引用块的一段，内部节点只记录左右子树
+    struct Node {
+        std::shared_ptr<Chunk> chunk;// 叶子所在的块
+        const char* data;// 叶子数据
+        NodePtr left;
+        NodePtr right;
+        size_t length;
+        int height;// 叶子为0
+    };
+
+    NodePtr root_;
+    // 末尾的叶子直接保存在对象中，短内容就地追加到块的剩余空间
+    std::shared_ptr<Chunk> tailChunk_;
+    size_t tailOffset_;
+    size_t tailLen_;
+
+    static int height(const NodePtr& node) {
+        return node ? node->height : -1;
+    }
+
+    static NodePtr makeLeaf(const std::shared_ptr<Chunk>& chunk, size_t offset, size_t len);
+    static NodePtr makeNode(const NodePtr& left, const NodePtr& right);
+    static NodePtr rotateLeft(const NodePtr& node);
+    static NodePtr rotateRight(const NodePtr& node);
+
+    // 拼接两棵平衡树，高度差超过1时沿较高一侧的边界下降后旋转
+    static NodePtr join(const NodePtr& left, const NodePtr& right);
+    static NodePtr joinRight(const NodePtr& left, const NodePtr& right);
+    static NodePtr joinLeft(const NodePtr& left, const NodePtr& right);
+
+    // 在pos处拆分为两棵平衡树
+    static void split(const NodePtr& node, size_t pos, NodePtr& left, NodePtr& right);
+
+    // 末尾叶子并入树中
+    void flushTail();
+
+    // 包含末尾叶子的整棵树
+    NodePtr whole() const;
+
+    template<typename Func>
+    static bool visit(const Node* node, Func& func) {
+        if (node->height == 0) {
+            return func(MStringView(node->data, node->length));
+        }
+        return visit(node->left.get(), func) && visit(node->right.get(), func);
+    }
+};
+
+#endif //MSTRINGROPE_H
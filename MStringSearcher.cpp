@@ -0,0 +1,99 @@
+#include "MStringSearcher.h"
+#include "MStringSimd.h"
+
+const size_t MStringSearcher::HORSPOOL_MIN_LENGTH;
+
+// 构造函数：拷贝并预处理模式串
+MStringSearcher::MStringSearcher(MStringView pattern) : pattern_(pattern) {
+    size_t len = pattern_.length();
+    if (len <= 1) {
+        strategy_ = Strategy::SEARCH_BYTE;
+    } else if (len < HORSPOOL_MIN_LENGTH) {
+        strategy_ = Strategy::SEARCH_SIMD_PAIR;
+    } else {
+        strategy_ = Strategy::SEARCH_HORSPOOL;
+        // 坏字符规则：文本窗口最后一个字节决定可跳过的距离
+        skip_.assign(256, len);
+        const char* data = pattern_.getData();
+        for (size_t i = 0; i + 1 < len; ++i) {
+            skip_[static_cast<unsigned char>(data[i])] = len - 1 - i;
+        }
+    }
+}
+
+// 在text中查找，返回匹配位置指针，未找到返回nullptr
+const char* MStringSearcher::search(const char* text, size_t len) const {
+    size_t patternLen = pattern_.length();
+    if (patternLen == 0 || patternLen > len) {
+        return nullptr;
+    }
+    switch (strategy_) {
+        case Strategy::SEARCH_BYTE:
+            return static_cast<const char*>(memchr(text, pattern_.getData()[0], len));
+        case Strategy::SEARCH_SIMD_PAIR:
+            return MStringSimd::find(text, len, pattern_.getData(), patternLen);
+        case Strategy::SEARCH_HORSPOOL:
+            return searchHorspool(text, len);
+    }
+    return nullptr;
+}
+
+// Horspool查找
+const char* MStringSearcher::searchHorspool(const char* text, size_t len) const {
+    const char* pattern = pattern_.getData();
+    const size_t patternLen = pattern_.length();
+    const char lastChar = pattern[patternLen - 1];
+    const size_t* skip = skip_.data();
+
+    size_t pos = 0;
+    while (pos <= len - patternLen) {
+        char c = text[pos + patternLen - 1];
+        if (c == lastChar && memcmp(text + pos, pattern, patternLen - 1) == 0) {
+            return text + pos;
+        }
+        pos += skip[static_cast<unsigned char>(c)];
+    }
+    return nullptr;
+}
+
+// 查找模式串并返回开始位置，未找到返回-1
+int MStringSearcher::find(MStringView text, size_t startPos) const {
+    if (startPos >= text.length()) {
+        return -1;
+    }
+    const char* pos = search(text.data() + startPos, text.length() - startPos);
+    return pos ? static_cast<int>(pos - text.data()) : -1;
+}
+
+// 查找所有不重叠的出现位置
+std::vector<int> MStringSearcher::findAll(MStringView text) const {
+    std::vector<int> positions;
+    size_t patternLen = pattern_.length();
+    if (patternLen == 0) {
+        return positions;
+    }
+    const char* begin = text.data();
+    const char* end = begin + text.length();
+    const char* pos = begin;
+    while ((pos = search(pos, end - pos)) != nullptr) {
+        positions.push_back(static_cast<int>(pos - begin));
+        pos += patternLen;
+    }
+    return positions;
+}
+
+// 统计不重叠的出现次数
+size_t MStringSearcher::count(MStringView text) const {
+    size_t patternLen = pattern_.length();
+    if (patternLen == 0) {
+        return 0;
+    }
+    size_t total = 0;
+    const char* end = text.data() + text.length();
+    const char* pos = text.data();
+    while ((pos = search(pos, end - pos)) != nullptr) {
+        ++total;
+        pos += patternLen;
+    }
+    return total;
+}
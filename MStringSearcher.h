@@ -0,0 +1,58 @@
+#ifndef MSTRINGSEARCHER_H
+#define MSTRINGSEARCHER_H
+
+#include <vector>
+#include "MString.h"
+
+// 预编译的子串查找器：构造时预处理模式串一次，之后可在大量字符串中重复查找
+// 构造完成后只读，可在多个线程间共享同一个查找器
+class MStringSearcher {
+public:
+    enum class Strategy {// 查找策略，按模式串长度选择
+        SEARCH_BYTE,// 单字节：memchr
+        SEARCH_SIMD_PAIR,// 中短模式串：SIMD首尾字节过滤
+        SEARCH_HORSPOOL// 长模式串：Horspool坏字符跳转
+    };
+
+    // 模式串长度达到该值时使用Horspool
+    static const size_t HORSPOOL_MIN_LENGTH = 32;
+
+    // 构造函数：拷贝并预处理模式串
+    explicit MStringSearcher(MStringView pattern);
+
+    // 查找模式串并返回开始位置，未找到返回-1
+    int find(MStringView text, size_t startPos = 0) const;
+
+    // 查找所有不重叠的出现位置
+    std::vector<int> findAll(MStringView text) const;
+
+    // 统计不重叠的出现次数
+    size_t count(MStringView text) const;
+
+    // 判断是否包含模式串
+    bool contains(MStringView text) const {
+        return find(text) != -1;
+    }
+
+    // 模式串
+    const MString& pattern() const {
+        return pattern_;
+    }
+
+    // 当前使用的查找策略
+    Strategy strategy() const {
+        return strategy_;
+    }
+private:
+    MString pattern_;// 模式串
+    Strategy strategy_;// 查找策略
+    std::vector<size_t> skip_;// Horspool坏字符跳转表（256项），仅长模式串使用
+
+    // 在text中查找，返回匹配位置指针，未找到返回nullptr
+    const char* search(const char* text, size_t len) const;
+
+    // Horspool查找
+    const char* searchHorspool(const char* text, size_t len) const;
+};
+
+#endif //MSTRINGSEARCHER_H
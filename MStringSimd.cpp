@@ -0,0 +1,1258 @@
+#include "MStringSimd.h"
+#include <cstring>
+#include <cstdint>
+
+#ifdef MSTRING_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MSTRING_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// GCC/Clang需要为AVX2函数单独指定目标指令集，MSVC可直接使用
+#if defined(__GNUC__) || defined(__clang__)
+#define MSTRING_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MSTRING_TARGET_AVX2
+#endif
+
+typedef const char* (*SearchFunc)(const char* data, size_t len, const char* pattern, size_t patternLen);
+typedef void (*CaseMapFunc)(char* out, const char* data, size_t len, char first);
+typedef int (*CompareFunc)(const char* a, const char* b, size_t len);
+typedef size_t (*LengthFunc)(const char* data, size_t len);
+typedef bool (*ValidateFunc)(const char* data, size_t len);
+typedef size_t (*OffsetFunc)(const char* data, size_t len, size_t index);
+
+// 字符集合不超过该大小时使用SIMD逐字符比较，否则查表
+static const size_t ANY_OF_SIMD_MAX = 16;
+
+// 最低位1的下标（mask不为0）
+static inline unsigned lowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// 最高位1的下标（mask不为0）
+static inline unsigned highestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+// 1的个数
+static inline unsigned popCount(uint32_t mask) {
+#ifdef _MSC_VER
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+// 第n个（从0开始）1的下标（mask中1的个数大于n）
+static inline unsigned nthBit(uint32_t mask, size_t n) {
+    for (; n > 0; --n) {
+        mask &= mask - 1;
+    }
+    return lowestBit(mask);
+}
+
+// 比较首尾字节之外的部分（首尾字节已由SIMD过滤）
+static inline bool matchMiddle(const char* candidate, const char* pattern, size_t patternLen) {
+    return patternLen <= 2 || memcmp(candidate + 1, pattern + 1, patternLen - 2) == 0;
+}
+
+// 标量正向查找：memchr定位首字节后比较
+static const char* findScalar(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    if (patternLen > len) {
+        return nullptr;
+    }
+    const char* last = data + len - patternLen;
+    for (const char* pos = data; pos <= last; ++pos) {
+        pos = static_cast<const char*>(memchr(pos, pattern[0], last - pos + 1));
+        if (pos == nullptr) {
+            return nullptr;
+        }
+        if (memcmp(pos + 1, pattern + 1, patternLen - 1) == 0) {
+            return pos;
+        }
+    }
+    return nullptr;
+}
+
+// 标量反向查找
+static const char* rfindScalar(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    if (patternLen > len) {
+        return nullptr;
+    }
+    for (size_t i = len - patternLen + 1; i-- > 0;) {
+        if (data[i] == pattern[0] && memcmp(data + i + 1, pattern + 1, patternLen - 1) == 0) {
+            return data + i;
+        }
+    }
+    return nullptr;
+}
+
+// 标量查找任一字符：字符集合较小时逐个比较，较大时查表
+static const char* findAnyOfScalar(const char* data, size_t len, const char* chars, size_t charsLen) {
+    if (charsLen <= ANY_OF_SIMD_MAX) {
+        for (size_t i = 0; i < len; ++i) {
+            if (memchr(chars, data[i], charsLen) != nullptr) {
+                return data + i;
+            }
+        }
+        return nullptr;
+    }
+    bool isTarget[256] = { false };
+    for (size_t i = 0; i < charsLen; ++i) {
+        isTarget[static_cast<unsigned char>(chars[i])] = true;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        if (isTarget[static_cast<unsigned char>(data[i])]) {
+            return data + i;
+        }
+    }
+    return nullptr;
+}
+
+// 字节c在[first, first + 25]范围内时翻转大小写位
+static inline char flipCase(char c, char first) {
+    return static_cast<char>(c ^ ((static_cast<unsigned char>(c - first) < 26) << 5));
+}
+
+// ASCII小写
+static inline unsigned char foldCase(char c) {
+    return static_cast<unsigned char>(flipCase(c, 'A'));
+}
+
+// 标量大小写转换：first为'A'时转小写，为'a'时转大写
+static void mapCaseScalar(char* out, const char* data, size_t len, char first) {
+    for (size_t i = 0; i < len; ++i) {
+        out[i] = flipCase(data[i], first);
+    }
+}
+
+// 标量忽略大小写比较
+static int compareIgnoreCaseScalar(const char* a, const char* b, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char ca = foldCase(a[i]);
+        unsigned char cb = foldCase(b[i]);
+        if (ca != cb) {
+            return ca < cb ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// 标量忽略大小写查找
+static const char* findIgnoreCaseScalar(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    if (patternLen > len) {
+        return nullptr;
+    }
+    const unsigned char first = foldCase(pattern[0]);
+    for (size_t i = 0; i + patternLen <= len; ++i) {
+        if (foldCase(data[i]) == first && MStringSimd::compareIgnoreCase(data + i + 1, pattern + 1, patternLen - 1) == 0) {
+            return data + i;
+        }
+    }
+    return nullptr;
+}
+
+// 标量ASCII前缀长度
+static size_t asciiLengthScalar(const char* data, size_t len) {
+    size_t i = 0;
+    while (i < len && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// 从s开始的一个完整合法UTF-8序列的长度，非法或不完整返回0
+static size_t utf8SequenceLength(const unsigned char* s, size_t len) {
+    unsigned char lead = s[0];
+    if (lead < 0x80) {
+        return 1;
+    }
+    size_t n = 0;
+    unsigned char low = 0x80;// 第二字节的取值范围，排除过长编码、代理区和超过U+10FFFF的码点
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        n = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        n = 3;
+        if (lead == 0xE0) {
+            low = 0xA0;
+        } else if (lead == 0xED) {
+            high = 0x9F;
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        n = 4;
+        if (lead == 0xF0) {
+            low = 0x90;
+        } else if (lead == 0xF4) {
+            high = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+    if (len < n || s[1] < low || s[1] > high) {
+        return 0;
+    }
+    for (size_t i = 2; i < n; ++i) {
+        if ((s[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return n;
+}
+
+// 标量UTF-8校验
+static bool validateUtf8Scalar(const char* data, size_t len) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(data);
+    size_t i = 0;
+    while (i < len) {
+        if (s[i] < 0x80) {
+            ++i;
+            continue;
+        }
+        size_t n = utf8SequenceLength(s + i, len - i);
+        if (n == 0) {
+            return false;
+        }
+        i += n;
+    }
+    return true;
+}
+
+// 标量码点计数
+static size_t countCodePointsScalar(const char* data, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; ++i) {
+        count += (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+// 标量查找第index个码点的字节偏移
+static size_t codePointOffsetScalar(const char* data, size_t len, size_t index) {
+    for (size_t i = 0; i < len; ++i) {
+        if ((static_cast<unsigned char>(data[i]) & 0xC0) != 0x80) {
+            if (index == 0) {
+                return i;
+            }
+            --index;
+        }
+    }
+    return len;
+}
+
+// 在mask标记的候选位置中正向确认匹配（忽略大小写，首尾字节已由SIMD过滤）
+static inline const char* firstMatchIgnoreCase(uint32_t mask, const char* base, const char* pattern, size_t patternLen) {
+    while (mask != 0) {
+        unsigned bit = lowestBit(mask);
+        if (patternLen <= 2 || MStringSimd::compareIgnoreCase(base + bit + 1, pattern + 1, patternLen - 2) == 0) {
+            return base + bit;
+        }
+        mask &= mask - 1;
+    }
+    return nullptr;
+}
+
+// 在mask标记的候选位置中正向确认匹配
+static inline const char* firstMatch(uint32_t mask, const char* base, const char* pattern, size_t patternLen) {
+    while (mask != 0) {
+        unsigned bit = lowestBit(mask);
+        if (matchMiddle(base + bit, pattern, patternLen)) {
+            return base + bit;
+        }
+        mask &= mask - 1;
+    }
+    return nullptr;
+}
+
+// 在mask标记的候选位置中反向确认匹配
+static inline const char* lastMatch(uint32_t mask, const char* base, const char* pattern, size_t patternLen) {
+    while (mask != 0) {
+        unsigned bit = highestBit(mask);
+        if (matchMiddle(base + bit, pattern, patternLen)) {
+            return base + bit;
+        }
+        mask &= ~(1u << bit);
+    }
+    return nullptr;
+}
+
+#ifdef MSTRING_SIMD_SSE2
+// 16个候选起始位置中首尾字节同时匹配的位置掩码
+static inline uint32_t candidateMask16(const char* base, size_t patternLen, __m128i first, __m128i last) {
+    __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base));
+    __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + patternLen - 1));
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+}
+
+// SSE2正向查找：每次检查16个候选起始位置，首尾字节同时匹配的位置再用memcmp确认
+static const char* findSse2(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    const size_t candidates = len - patternLen + 1;// 候选起始位置数量
+    if (candidates < 16) {
+        return findScalar(data, len, pattern, patternLen);
+    }
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last = _mm_set1_epi8(pattern[patternLen - 1]);
+    size_t i = 0;
+    for (; i + 16 <= candidates; i += 16) {
+        const char* found = firstMatch(candidateMask16(data + i, patternLen, first, last), data + i, pattern, patternLen);
+        if (found != nullptr) {
+            return found;
+        }
+    }
+    if (i == candidates) {
+        return nullptr;
+    }
+    // 剩余不足16个候选位置：与前一组重叠读取最后16个，屏蔽已检查的位置
+    size_t base = candidates - 16;
+    uint32_t mask = candidateMask16(data + base, patternLen, first, last) & (0xFFFFu << (i - base));
+    return firstMatch(mask, data + base, pattern, patternLen);
+}
+
+// SSE2反向查找：从尾部按16个候选位置一组向前检查
+static const char* rfindSse2(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    size_t i = len - patternLen + 1;// 剩余候选起始位置 [0, i)
+    if (i < 16) {
+        return rfindScalar(data, len, pattern, patternLen);
+    }
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last = _mm_set1_epi8(pattern[patternLen - 1]);
+    for (; i >= 16; i -= 16) {
+        const char* found = lastMatch(candidateMask16(data + i - 16, patternLen, first, last), data + i - 16, pattern, patternLen);
+        if (found != nullptr) {
+            return found;
+        }
+    }
+    if (i == 0) {
+        return nullptr;
+    }
+    // 剩余不足16个候选位置：重叠读取开头16个，只保留[0, i)
+    uint32_t mask = candidateMask16(data, patternLen, first, last) & ((1u << i) - 1);
+    return lastMatch(mask, data, pattern, patternLen);
+}
+
+// 16个字节中属于字符集合的位置掩码
+static inline uint32_t anyOfMask16(const char* base, const __m128i* targets, size_t charsLen) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base));
+    __m128i hit = _mm_cmpeq_epi8(block, targets[0]);
+    for (size_t c = 1; c < charsLen; ++c) {
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, targets[c]));
+    }
+    return static_cast<uint32_t>(_mm_movemask_epi8(hit));
+}
+
+// SSE2查找任一字符：每个字符广播后与16字节块比较，结果按位或
+static const char* findAnyOfSse2(const char* data, size_t len, const char* chars, size_t charsLen) {
+    if (len < 16 || charsLen > ANY_OF_SIMD_MAX) {
+        return findAnyOfScalar(data, len, chars, charsLen);
+    }
+    __m128i targets[ANY_OF_SIMD_MAX];
+    for (size_t c = 0; c < charsLen; ++c) {
+        targets[c] = _mm_set1_epi8(chars[c]);
+    }
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t mask = anyOfMask16(data + i, targets, charsLen);
+        if (mask != 0) {
+            return data + i + lowestBit(mask);
+        }
+    }
+    if (i == len) {
+        return nullptr;
+    }
+    size_t base = len - 16;
+    uint32_t mask = anyOfMask16(data + base, targets, charsLen) & (0xFFFFu << (i - base));
+    return mask != 0 ? data + base + lowestBit(mask) : nullptr;
+}
+
+// 16个字节中[first, first + 25]范围内的字节翻转大小写位（有符号比较，非ASCII字节为负数不受影响）
+static inline __m128i flipCase16(__m128i block, char first) {
+    __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(first - 1))),
+                                    _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(first + 26))));
+    return _mm_xor_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+}
+
+// SSE2大小写转换
+static void mapCaseSse2(char* out, const char* data, size_t len, char first) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), flipCase16(block, first));
+    }
+    mapCaseScalar(out + i, data + i, len - i, first);
+}
+
+// SSE2忽略大小写比较：两侧都转为小写后逐块比较
+static int compareIgnoreCaseSse2(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i blockA = flipCase16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), 'A');
+        __m128i blockB = flipCase16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), 'A');
+        uint32_t diff = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB))) ^ 0xFFFFu;
+        if (diff != 0) {
+            unsigned bit = lowestBit(diff);
+            return foldCase(a[i + bit]) < foldCase(b[i + bit]) ? -1 : 1;
+        }
+    }
+    return compareIgnoreCaseScalar(a + i, b + i, len - i);
+}
+
+// 16个候选起始位置中首尾字节忽略大小写后同时匹配的位置掩码（first/last为小写）
+static inline uint32_t candidateMaskIgnoreCase16(const char* base, size_t patternLen, __m128i first, __m128i last) {
+    __m128i blockFirst = flipCase16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(base)), 'A');
+    __m128i blockLast = flipCase16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(base + patternLen - 1)), 'A');
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+}
+
+// SSE2忽略大小写查找
+static const char* findIgnoreCaseSse2(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    const size_t candidates = len - patternLen + 1;
+    if (candidates < 16) {
+        return findIgnoreCaseScalar(data, len, pattern, patternLen);
+    }
+    const __m128i first = _mm_set1_epi8(static_cast<char>(foldCase(pattern[0])));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(foldCase(pattern[patternLen - 1])));
+    size_t i = 0;
+    for (; i + 16 <= candidates; i += 16) {
+        uint32_t mask = candidateMaskIgnoreCase16(data + i, patternLen, first, last);
+        const char* found = firstMatchIgnoreCase(mask, data + i, pattern, patternLen);
+        if (found != nullptr) {
+            return found;
+        }
+    }
+    if (i == candidates) {
+        return nullptr;
+    }
+    size_t base = candidates - 16;
+    uint32_t mask = candidateMaskIgnoreCase16(data + base, patternLen, first, last) & (0xFFFFu << (i - base));
+    return firstMatchIgnoreCase(mask, data + base, pattern, patternLen);
+}
+
+// SSE2 ASCII前缀长度
+static size_t asciiLengthSse2(const char* data, size_t len) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+        if (mask != 0) {
+            return i + lowestBit(mask);
+        }
+    }
+    return i + asciiLengthScalar(data + i, len - i);
+}
+
+// SSE2 UTF-8校验：ASCII块每次跳过16字节，遇到非ASCII字节后逐序列校验，直到回到ASCII
+static bool validateUtf8Sse2(const char* data, size_t len) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(data);
+    size_t i = 0;
+    while (i + 16 <= len) {
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+        if (mask == 0) {
+            i += 16;
+            continue;
+        }
+        i += lowestBit(mask);
+        do {
+            size_t n = utf8SequenceLength(s + i, len - i);
+            if (n == 0) {
+                return false;
+            }
+            i += n;
+        } while (i < len && s[i] >= 0x80);
+    }
+    return validateUtf8Scalar(data + i, len - i);
+}
+
+// 16个字节中非后续字节的掩码：有符号比较时后续字节0x80-0xBF为-128到-65
+static inline __m128i leadBytes16(__m128i block) {
+    return _mm_cmpgt_epi8(block, _mm_set1_epi8(-65));
+}
+
+// SSE2码点计数：每个字节位置的计数器最多累加255次后横向求和
+static size_t countCodePointsSse2(const char* data, size_t len) {
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 16 <= len) {
+        __m128i counter = _mm_setzero_si128();
+        for (size_t k = 0; k < 255 && i + 16 <= len; ++k, i += 16) {
+            counter = _mm_sub_epi8(counter, leadBytes16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+        }
+        uint64_t sums[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), _mm_sad_epu8(counter, _mm_setzero_si128()));
+        count += static_cast<size_t>(sums[0] + sums[1]);
+    }
+    return count + countCodePointsScalar(data + i, len - i);
+}
+
+// SSE2查找第index个码点的字节偏移：整块跳过，目标所在的块内按位查找
+static size_t codePointOffsetSse2(const char* data, size_t len, size_t index) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(leadBytes16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)))));
+        size_t count = popCount(mask);
+        if (count > index) {
+            return i + nthBit(mask, index);
+        }
+        index -= count;
+    }
+    return i + codePointOffsetScalar(data + i, len - i, index);
+}
+#endif
+
+#ifdef MSTRING_SIMD_AVX2
+// 32个候选起始位置中首尾字节同时匹配的位置掩码
+MSTRING_TARGET_AVX2
+static inline uint32_t candidateMask32(const char* base, size_t patternLen, __m256i first, __m256i last) {
+    __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base));
+    __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + patternLen - 1));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+}
+
+// AVX2正向查找：每次检查32个候选起始位置
+MSTRING_TARGET_AVX2
+static const char* findAvx2(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    const size_t candidates = len - patternLen + 1;
+    if (candidates < 32) {
+        return findSse2(data, len, pattern, patternLen);
+    }
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last = _mm256_set1_epi8(pattern[patternLen - 1]);
+    size_t i = 0;
+    for (; i + 32 <= candidates; i += 32) {
+        const char* found = firstMatch(candidateMask32(data + i, patternLen, first, last), data + i, pattern, patternLen);
+        if (found != nullptr) {
+            return found;
+        }
+    }
+    if (i == candidates) {
+        return nullptr;
+    }
+    size_t base = candidates - 32;
+    uint32_t mask = candidateMask32(data + base, patternLen, first, last) & (0xFFFFFFFFu << (i - base));
+    return firstMatch(mask, data + base, pattern, patternLen);
+}
+
+// AVX2反向查找
+MSTRING_TARGET_AVX2
+static const char* rfindAvx2(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    size_t i = len - patternLen + 1;
+    if (i < 32) {
+        return rfindSse2(data, len, pattern, patternLen);
+    }
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last = _mm256_set1_epi8(pattern[patternLen - 1]);
+    for (; i >= 32; i -= 32) {
+        const char* found = lastMatch(candidateMask32(data + i - 32, patternLen, first, last), data + i - 32, pattern, patternLen);
+        if (found != nullptr) {
+            return found;
+        }
+    }
+    if (i == 0) {
+        return nullptr;
+    }
+    uint32_t mask = candidateMask32(data, patternLen, first, last) & ((1u << i) - 1);
+    return lastMatch(mask, data, pattern, patternLen);
+}
+
+// 32个字节中属于字符集合的位置掩码
+MSTRING_TARGET_AVX2
+static inline uint32_t anyOfMask32(const char* base, const __m256i* targets, size_t charsLen) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base));
+    __m256i hit = _mm256_cmpeq_epi8(block, targets[0]);
+    for (size_t c = 1; c < charsLen; ++c) {
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, targets[c]));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+}
+
+// AVX2查找任一字符
+MSTRING_TARGET_AVX2
+static const char* findAnyOfAvx2(const char* data, size_t len, const char* chars, size_t charsLen) {
+    if (len < 32 || charsLen > ANY_OF_SIMD_MAX) {
+        return findAnyOfSse2(data, len, chars, charsLen);
+    }
+    __m256i targets[ANY_OF_SIMD_MAX];
+    for (size_t c = 0; c < charsLen; ++c) {
+        targets[c] = _mm256_set1_epi8(chars[c]);
+    }
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        uint32_t mask = anyOfMask32(data + i, targets, charsLen);
+        if (mask != 0) {
+            return data + i + lowestBit(mask);
+        }
+    }
+    if (i == len) {
+        return nullptr;
+    }
+    size_t base = len - 32;
+    uint32_t mask = anyOfMask32(data + base, targets, charsLen) & (0xFFFFFFFFu << (i - base));
+    return mask != 0 ? data + base + lowestBit(mask) : nullptr;
+}
+
+// 32个字节中[first, first + 25]范围内的字节翻转大小写位
+MSTRING_TARGET_AVX2
+static inline __m256i flipCase32(__m256i block, char first) {
+    __m256i inRange = _mm256_andnot_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(first)), block),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(first + 26)), block));
+    return _mm256_xor_si256(block, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+}
+
+// AVX2大小写转换
+MSTRING_TARGET_AVX2
+static void mapCaseAvx2(char* out, const char* data, size_t len, char first) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), flipCase32(block, first));
+    }
+    mapCaseSse2(out + i, data + i, len - i, first);
+}
+
+// AVX2忽略大小写比较
+MSTRING_TARGET_AVX2
+static int compareIgnoreCaseAvx2(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i blockA = flipCase32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), 'A');
+        __m256i blockB = flipCase32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)), 'A');
+        uint32_t diff = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockA, blockB)));
+        if (diff != 0) {
+            unsigned bit = lowestBit(diff);
+            return foldCase(a[i + bit]) < foldCase(b[i + bit]) ? -1 : 1;
+        }
+    }
+    return compareIgnoreCaseSse2(a + i, b + i, len - i);
+}
+
+// 32个候选起始位置中首尾字节忽略大小写后同时匹配的位置掩码
+MSTRING_TARGET_AVX2
+static inline uint32_t candidateMaskIgnoreCase32(const char* base, size_t patternLen, __m256i first, __m256i last) {
+    __m256i blockFirst = flipCase32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(base)), 'A');
+    __m256i blockLast = flipCase32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + patternLen - 1)), 'A');
+    return static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+}
+
+// AVX2忽略大小写查找
+MSTRING_TARGET_AVX2
+static const char* findIgnoreCaseAvx2(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    const size_t candidates = len - patternLen + 1;
+    if (candidates < 32) {
+        return findIgnoreCaseSse2(data, len, pattern, patternLen);
+    }
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(foldCase(pattern[0])));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(foldCase(pattern[patternLen - 1])));
+    size_t i = 0;
+    for (; i + 32 <= candidates; i += 32) {
+        uint32_t mask = candidateMaskIgnoreCase32(data + i, patternLen, first, last);
+        const char* found = firstMatchIgnoreCase(mask, data + i, pattern, patternLen);
+        if (found != nullptr) {
+            return found;
+        }
+    }
+    if (i == candidates) {
+        return nullptr;
+    }
+    size_t base = candidates - 32;
+    uint32_t mask = candidateMaskIgnoreCase32(data + base, patternLen, first, last) & (0xFFFFFFFFu << (i - base));
+    return firstMatchIgnoreCase(mask, data + base, pattern, patternLen);
+}
+
+// AVX2 ASCII前缀长度
+MSTRING_TARGET_AVX2
+static size_t asciiLengthAvx2(const char* data, size_t len) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))));
+        if (mask != 0) {
+            return i + lowestBit(mask);
+        }
+    }
+    return i + asciiLengthSse2(data + i, len - i);
+}
+
+// UTF-8查表校验的错误类型：由前一字节的高/低4位和当前字节的高4位分别查表，三者按位与后非0即出错
+static const char UTF8_TOO_SHORT = 1 << 0;// 引导字节后缺少后续字节
+static const char UTF8_TOO_LONG = 1 << 1;// ASCII后出现后续字节
+static const char UTF8_OVERLONG_3 = 1 << 2;// E0 80-9F
+static const char UTF8_TOO_LARGE = 1 << 3;// F4 90-BF，F5-FF
+static const char UTF8_SURROGATE = 1 << 4;// ED A0-BF
+static const char UTF8_OVERLONG_2 = 1 << 5;// C0-C1
+static const char UTF8_TOO_LARGE_1000 = 1 << 6;// F5-FF 80-8F
+static const char UTF8_OVERLONG_4 = 1 << 6;// F0 80-8F
+static const char UTF8_TWO_CONTS = static_cast<char>(1 << 7);// 连续两个后续字节（三、四字节序列中合法）
+static const char UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+// 每个字节之前的第N个字节（跨越前一个块）
+template<int N>
+MSTRING_TARGET_AVX2
+static inline __m256i prevBytes(__m256i input, __m256i prev) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+// 每个字节的高4位
+MSTRING_TARGET_AVX2
+static inline __m256i highNibble(__m256i block) {
+    return _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F));
+}
+
+// 校验一个含非ASCII字节的块，返回错误标志
+MSTRING_TARGET_AVX2
+static inline __m256i checkUtf8Block(__m256i input, __m256i prev) {
+    const __m256i byte1HighTable = _mm256_setr_epi8(
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    const __m256i byte1LowTable = _mm256_setr_epi8(
+        UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+        UTF8_CARRY | UTF8_OVERLONG_2,
+        UTF8_CARRY, UTF8_CARRY,
+        UTF8_CARRY | UTF8_TOO_LARGE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+        UTF8_CARRY | UTF8_OVERLONG_2,
+        UTF8_CARRY, UTF8_CARRY,
+        UTF8_CARRY | UTF8_TOO_LARGE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000);
+    const char cont80 = UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4;
+    const char cont90 = UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE;
+    const char contA0 = UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE;
+    const __m256i byte2HighTable = _mm256_setr_epi8(
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        cont80, cont90, contA0, contA0,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        cont80, cont90, contA0, contA0,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+
+    __m256i prev1 = prevBytes<1>(input, prev);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(_mm256_shuffle_epi8(byte1HighTable, highNibble(prev1)),
+                         _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)))),
+        _mm256_shuffle_epi8(byte2HighTable, highNibble(input)));
+
+    // 三、四字节序列的第三、四个字节必须是后续字节，此时TWO_CONTS恰好应当出现
+    __m256i isThird = _mm256_subs_epu8(prevBytes<2>(input, prev), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i isFourth = _mm256_subs_epu8(prevBytes<3>(input, prev), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must23, special);
+}
+
+// AVX2 UTF-8校验：每次处理32字节，纯ASCII块只检查前一块是否以不完整的序列结尾
+MSTRING_TARGET_AVX2
+static bool validateUtf8Avx2(const char* data, size_t len) {
+    if (len < 32) {
+        return validateUtf8Sse2(data, len);
+    }
+    // 块末尾3个字节中的引导字节需要的后续字节超出块时，饱和减法结果非0
+    const __m256i incompleteMax = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev = _mm256_setzero_si256();
+    __m256i prevIncomplete = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, prevIncomplete);
+        } else {
+            error = _mm256_or_si256(error, checkUtf8Block(input, prev));
+            prevIncomplete = _mm256_subs_epu8(input, incompleteMax);
+        }
+        prev = input;
+        if (!_mm256_testz_si256(error, error)) {
+            return false;
+        }
+    }
+
+    // 最后一个块末尾可能有未结束的序列，从其引导字节开始校验剩余部分
+    size_t start = i;
+    for (size_t k = 1; k <= 3; ++k) {
+        unsigned char c = static_cast<unsigned char>(data[i - k]);
+        if (c >= 0xC0) {
+            start = i - k;
+            break;
+        }
+        if (c < 0x80) {
+            break;
+        }
+    }
+    return validateUtf8Sse2(data + start, len - start);
+}
+
+// 32个字节中非后续字节的掩码
+MSTRING_TARGET_AVX2
+static inline __m256i leadBytes32(__m256i block) {
+    return _mm256_cmpgt_epi8(block, _mm256_set1_epi8(-65));
+}
+
+// AVX2码点计数
+MSTRING_TARGET_AVX2
+static size_t countCodePointsAvx2(const char* data, size_t len) {
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 32 <= len) {
+        __m256i counter = _mm256_setzero_si256();
+        for (size_t k = 0; k < 255 && i + 32 <= len; ++k, i += 32) {
+            counter = _mm256_sub_epi8(counter, leadBytes32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))));
+        }
+        uint64_t sums[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), _mm256_sad_epu8(counter, _mm256_setzero_si256()));
+        count += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+    return count + countCodePointsSse2(data + i, len - i);
+}
+
+// AVX2查找第index个码点的字节偏移
+MSTRING_TARGET_AVX2
+static size_t codePointOffsetAvx2(const char* data, size_t len, size_t index) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(leadBytes32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)))));
+        size_t count = popCount(mask);
+        if (count > index) {
+            return i + nthBit(mask, index);
+        }
+        index -= count;
+    }
+    return i + codePointOffsetSse2(data + i, len - i, index);
+}
+#endif
+
+// 当前CPU是否支持AVX2
+bool MStringSimd::hasAvx2() {
+#if defined(MSTRING_SIMD_AVX2) && defined(_MSC_VER)
+    static const bool supported = []() {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        const int osxsave = 1 << 27;
+        const int avx = 1 << 28;
+        if ((info[2] & osxsave) == 0 || (info[2] & avx) == 0 || (_xgetbv(0) & 6) != 6) {
+            return false;// CPU或操作系统不支持AVX寄存器状态保存
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    return supported;
+#elif defined(MSTRING_SIMD_AVX2)
+    static const bool supported = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// 选择正向查找实现
+static SearchFunc selectFind() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return findAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return findSse2;
+#else
+    return findScalar;
+#endif
+}
+
+// 选择反向查找实现
+static SearchFunc selectRfind() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return rfindAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return rfindSse2;
+#else
+    return rfindScalar;
+#endif
+}
+
+// 选择字符集合查找实现
+static SearchFunc selectFindAnyOf() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return findAnyOfAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return findAnyOfSse2;
+#else
+    return findAnyOfScalar;
+#endif
+}
+
+// 选择大小写转换实现
+static CaseMapFunc selectMapCase() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return mapCaseAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return mapCaseSse2;
+#else
+    return mapCaseScalar;
+#endif
+}
+
+// 选择忽略大小写比较实现
+static CompareFunc selectCompareIgnoreCase() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return compareIgnoreCaseAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return compareIgnoreCaseSse2;
+#else
+    return compareIgnoreCaseScalar;
+#endif
+}
+
+// 选择忽略大小写查找实现
+static SearchFunc selectFindIgnoreCase() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return findIgnoreCaseAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return findIgnoreCaseSse2;
+#else
+    return findIgnoreCaseScalar;
+#endif
+}
+
+// 选择ASCII前缀长度实现
+static LengthFunc selectAsciiLength() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return asciiLengthAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return asciiLengthSse2;
+#else
+    return asciiLengthScalar;
+#endif
+}
+
+// 选择UTF-8校验实现
+static ValidateFunc selectValidateUtf8() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return validateUtf8Avx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return validateUtf8Sse2;
+#else
+    return validateUtf8Scalar;
+#endif
+}
+
+// 选择码点计数实现
+static LengthFunc selectCountCodePoints() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return countCodePointsAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return countCodePointsSse2;
+#else
+    return countCodePointsScalar;
+#endif
+}
+
+// 选择码点偏移查找实现
+static OffsetFunc selectCodePointOffset() {
+#ifdef MSTRING_SIMD_AVX2
+    if (MStringSimd::hasAvx2()) {
+        return codePointOffsetAvx2;
+    }
+#endif
+#ifdef MSTRING_SIMD_SSE2
+    return codePointOffsetSse2;
+#else
+    return codePointOffsetScalar;
+#endif
+}
+
+// 正向查找子串，返回首次出现的位置，未找到返回nullptr
+const char* MStringSimd::find(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    if (patternLen == 0 || patternLen > len) {
+        return nullptr;
+    }
+    if (patternLen == 1) {
+        return static_cast<const char*>(memchr(data, pattern[0], len));// 单字节直接使用memchr
+    }
+    static const SearchFunc func = selectFind();
+    return func(data, len, pattern, patternLen);
+}
+
+// 反向查找子串，返回最后一次出现的位置，未找到返回nullptr
+const char* MStringSimd::rfind(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    if (patternLen == 0 || patternLen > len) {
+        return nullptr;
+    }
+    static const SearchFunc func = selectRfind();
+    return func(data, len, pattern, patternLen);
+}
+
+// 查找chars中任一字符首次出现的位置，未找到返回nullptr
+const char* MStringSimd::findAnyOf(const char* data, size_t len, const char* chars, size_t charsLen) {
+    if (charsLen == 0 || len == 0) {
+        return nullptr;
+    }
+    if (charsLen == 1) {
+        return static_cast<const char*>(memchr(data, chars[0], len));
+    }
+    static const SearchFunc func = selectFindAnyOf();
+    return func(data, len, chars, charsLen);
+}
+
+// ASCII字母转换为大写
+void MStringSimd::toUpper(char* out, const char* data, size_t len) {
+    static const CaseMapFunc func = selectMapCase();
+    func(out, data, len, 'a');
+}
+
+// ASCII字母转换为小写
+void MStringSimd::toLower(char* out, const char* data, size_t len) {
+    static const CaseMapFunc func = selectMapCase();
+    func(out, data, len, 'A');
+}
+
+// 忽略ASCII大小写比较len个字节
+int MStringSimd::compareIgnoreCase(const char* a, const char* b, size_t len) {
+    static const CompareFunc func = selectCompareIgnoreCase();
+    return func(a, b, len);
+}
+
+// 忽略ASCII大小写正向查找子串
+const char* MStringSimd::findIgnoreCase(const char* data, size_t len, const char* pattern, size_t patternLen) {
+    if (patternLen == 0 || patternLen > len) {
+        return nullptr;
+    }
+    static const SearchFunc func = selectFindIgnoreCase();
+    return func(data, len, pattern, patternLen);
+}
+
+// 开头连续ASCII字节的长度
+size_t MStringSimd::asciiLength(const char* data, size_t len) {
+    static const LengthFunc func = selectAsciiLength();
+    return func(data, len);
+}
+
+// 严格校验UTF-8
+bool MStringSimd::validateUtf8(const char* data, size_t len) {
+    static const ValidateFunc func = selectValidateUtf8();
+    return func(data, len);
+}
+
+// ASCII字节扩展为UTF-16编码单元
+void MStringSimd::widenAscii(char* out, const char* data, size_t len, bool bigEndian) {
+    size_t i = 0;
+#ifdef MSTRING_SIMD_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i low = bigEndian ? _mm_unpacklo_epi8(zero, block) : _mm_unpacklo_epi8(block, zero);
+        __m128i high = bigEndian ? _mm_unpackhi_epi8(zero, block) : _mm_unpackhi_epi8(block, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), high);
+    }
+#endif
+    for (; i < len; ++i) {
+        out[2 * i + (bigEndian ? 1 : 0)] = data[i];
+        out[2 * i + (bigEndian ? 0 : 1)] = 0;
+    }
+}
+
+// 开头连续的ASCII UTF-16编码单元压缩为单字节
+size_t MStringSimd::narrowAscii(char* out, const char* data, size_t units, bool bigEndian) {
+    size_t i = 0;
+#ifdef MSTRING_SIMD_SSE2
+    const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 16 <= units; i += 16) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 2 * i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 2 * i + 16));
+        if (bigEndian) {
+            low = _mm_or_si128(_mm_slli_epi16(low, 8), _mm_srli_epi16(low, 8));
+            high = _mm_or_si128(_mm_slli_epi16(high, 8), _mm_srli_epi16(high, 8));
+        }
+        __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(low, high), nonAscii), _mm_setzero_si128());
+        if (_mm_movemask_epi8(ascii) != 0xFFFF) {
+            break;// 块中有非ASCII单元，剩余部分逐个处理
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < units; ++i) {
+        unsigned char low = static_cast<unsigned char>(data[2 * i + (bigEndian ? 1 : 0)]);
+        unsigned char high = static_cast<unsigned char>(data[2 * i + (bigEndian ? 0 : 1)]);
+        if (high != 0 || low >= 0x80) {
+            break;
+        }
+        out[i] = static_cast<char>(low);
+    }
+    return i;
+}
+
+// UTF-8码点数
+size_t MStringSimd::countCodePoints(const char* data, size_t len) {
+    static const LengthFunc func = selectCountCodePoints();
+    return func(data, len);
+}
+
+// 第index个码点的字节偏移
+size_t MStringSimd::codePointOffset(const char* data, size_t len, size_t index) {
+    static const OffsetFunc func = selectCodePointOffset();
+    return func(data, len, index);
+}
+
+// 十六进制字符的值，非法字符返回-1
+static inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    char lower = static_cast<char>(c | 0x20);
+    return (lower >= 'a' && lower <= 'f') ? lower - 'a' + 10 : -1;
+}
+
+#ifdef MSTRING_SIMD_SSE2
+// 16个0-15的值转换为十六进制字符
+static inline __m128i hexDigits16(__m128i values, __m128i letterOffset) {
+    __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(values, _mm_set1_epi8(9)), letterOffset);
+    return _mm_add_epi8(_mm_add_epi8(values, _mm_set1_epi8('0')), letters);
+}
+#endif
+
+// 十六进制编码：每16个字节拆分高低4位后交错排列
+void MStringSimd::hexEncode(char* out, const char* data, size_t len, bool upperCase) {
+    const char* digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+    size_t i = 0;
+#ifdef MSTRING_SIMD_SSE2
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    const __m128i letterOffset = _mm_set1_epi8(upperCase ? 'A' - '0' - 10 : 'a' - '0' - 10);
+    for (; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), lowMask);
+        __m128i low = _mm_and_si128(block, lowMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), hexDigits16(_mm_unpacklo_epi8(high, low), letterOffset));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), hexDigits16(_mm_unpackhi_epi8(high, low), letterOffset));
+    }
+#endif
+    for (; i < len; ++i) {
+        unsigned char byte = static_cast<unsigned char>(data[i]);
+        out[2 * i] = digits[byte >> 4];
+        out[2 * i + 1] = digits[byte & 0x0F];
+    }
+}
+
+// 十六进制解码：每32个字符校验后两两合并为16个字节，块中有非法字符时转为逐个处理
+size_t MStringSimd::hexDecode(char* out, const char* hex, size_t bytes) {
+    size_t i = 0;
+#ifdef MSTRING_SIMD_SSE2
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i packed[2];
+        bool valid = true;
+        for (int half = 0; half < 2; ++half) {
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i + 16 * half));
+            __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+            __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+            __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+            if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+                valid = false;
+                break;
+            }
+            __m128i values = _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                                          _mm_andnot_si128(isDigit, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+            // 小端序下每个16位单元的低字节是高4位
+            __m128i high = _mm_and_si128(values, _mm_set1_epi16(0x00FF));
+            __m128i low = _mm_srli_epi16(values, 8);
+            packed[half] = _mm_or_si128(_mm_slli_epi16(high, 4), low);
+        }
+        if (!valid) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(packed[0], packed[1]));
+    }
+#endif
+    for (; i < bytes; ++i) {
+        int high = hexValue(hex[2 * i]);
+        int low = hexValue(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            break;
+        }
+        out[i] = static_cast<char>((high << 4) | low);
+    }
+    return i;
+}
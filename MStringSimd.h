@@ -0,0 +1,66 @@
+#ifndef MSTRINGSIMD_H
+#define MSTRINGSIMD_H
+
+#include <cstddef>
+
+// x86平台启用SSE2（x86-64默认支持），AVX2在运行时检测CPU后启用，其他平台使用标量实现
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MSTRING_SIMD_SSE2 1
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define MSTRING_SIMD_AVX2 1
+#endif
+#endif
+
+// 字符串SIMD内核：按运行时CPU特性分派到AVX2/SSE2/标量实现
+class MStringSimd {
+public:
+    // 当前CPU是否支持AVX2
+    static bool hasAvx2();
+
+    // 正向查找子串，返回首次出现的位置，未找到返回nullptr
+    static const char* find(const char* data, size_t len, const char* pattern, size_t patternLen);
+
+    // 反向查找子串，返回最后一次出现的位置，未找到返回nullptr
+    static const char* rfind(const char* data, size_t len, const char* pattern, size_t patternLen);
+
+    // 查找chars中任一字符首次出现的位置，未找到返回nullptr
+    static const char* findAnyOf(const char* data, size_t len, const char* chars, size_t charsLen);
+
+    // ASCII字母转换为大写/小写，写入out（out可以与data相同），非ASCII字节保持不变
+    static void toUpper(char* out, const char* data, size_t len);
+    static void toLower(char* out, const char* data, size_t len);
+
+    // 忽略ASCII大小写比较len个字节（按小写后的无符号字节序），返回值与memcmp含义相同
+    static int compareIgnoreCase(const char* a, const char* b, size_t len);
+
+    // 忽略ASCII大小写正向查找子串，返回首次出现的位置，未找到返回nullptr
+    static const char* findIgnoreCase(const char* data, size_t len, const char* pattern, size_t patternLen);
+
+    // 开头连续ASCII字节（0x00-0x7F）的长度
+    static size_t asciiLength(const char* data, size_t len);
+
+    // 严格校验UTF-8：拒绝过长编码、代理区（U+D800-U+DFFF）、超过U+10FFFF的码点及不完整的序列
+    static bool validateUtf8(const char* data, size_t len);
+
+    // len个ASCII字节扩展为UTF-16编码单元写入out（2 * len字节），调用方保证输入全部为ASCII
+    static void widenAscii(char* out, const char* data, size_t len, bool bigEndian);
+
+    // 开头连续的ASCII UTF-16编码单元（最多units个）压缩为单字节写入out，返回转换的单元数
+    static size_t narrowAscii(char* out, const char* data, size_t units, bool bigEndian);
+
+    // UTF-8码点数：统计非后续字节（不是10xxxxxx的字节）
+    static size_t countCodePoints(const char* data, size_t len);
+
+    // 第index个码点（从0开始）的字节偏移，即第index个非后续字节的位置，码点不足时返回len
+    static size_t codePointOffset(const char* data, size_t len, size_t index);
+
+    // 每字节编码为两个十六进制字符写入out（2 * len字节），不含分隔符
+    static void hexEncode(char* out, const char* data, size_t len, bool upperCase);
+
+    // 每两个十六进制字符（大小写均可）解码为一个字节写入out，遇到非法字符时停止，返回解码的字节数
+    static size_t hexDecode(char* out, const char* hex, size_t bytes);
+private:
+    MStringSimd();
+};
+
+#endif //MSTRINGSIMD_H
@@ -0,0 +1,295 @@
+#include "MString.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <thread>
+
+// 排序键：缓存从depth开始的8字节（大端序，不足补0），比较前缀时不访问字符串本身
+struct MStringSortKey {
+    uint64_t prefix;
+    const char* data;
+    size_t len;
+    size_t index;// 在原序列中的位置
+};
+
+// 基数排序中直接比较排序的阈值
+static const size_t SMALL_SORT_SIZE = 64;
+
+// 启用多线程的最小数据量
+static const size_t PARALLEL_SORT_SIZE = 1 << 16;
+
+// 最大线程数（保证每个桶有足够的采样）
+static const unsigned MAX_SORT_THREADS = 256;
+
+// 读取从depth开始的8字节前缀
+static inline uint64_t loadPrefix(const char* data, size_t len, size_t depth) {
+    uint64_t prefix = 0;
+    size_t n = len > depth ? len - depth : 0;
+    if (n >= 8) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data + depth);
+        for (int i = 0; i < 8; ++i) {
+            prefix = (prefix << 8) | p[i];
+        }
+        return prefix;
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        prefix = (prefix << 8) | (i < n ? static_cast<unsigned char>(data[depth + i]) : 0);
+    }
+    return prefix;
+}
+
+// 前缀相同时从from开始比较剩余部分，剩余部分相同时短的在前（补0的前缀无法区分长度）
+static inline bool tailLess(const MStringSortKey& a, const MStringSortKey& b, size_t from) {
+    size_t lenA = a.len > from ? a.len - from : 0;
+    size_t lenB = b.len > from ? b.len - from : 0;
+    size_t n = lenA < lenB ? lenA : lenB;
+    int res = n > 0 ? memcmp(a.data + from, b.data + from, n) : 0;
+    return res != 0 ? res < 0 : a.len < b.len;
+}
+
+// 小区间直接比较排序，前缀在depth处加载
+static void smallSort(MStringSortKey* keys, size_t n, size_t depth) {
+    std::sort(keys, keys + n, [depth](const MStringSortKey& a, const MStringSortKey& b) {
+        if (a.prefix != b.prefix) {
+            return a.prefix < b.prefix;
+        }
+        return tailLess(a, b, depth + 8);
+    });
+}
+
+// MSD基数排序：按前缀的第byte个字节分桶，8个字节都相同时在depth + 8处重新加载前缀
+// 公共前缀（只有一个桶、重新加载前缀）和最大的桶在循环中继续处理，只对较小的桶递归，递归深度不超过log2(n)
+static void radixSort(MStringSortKey* keys, MStringSortKey* temp, size_t n, size_t depth, int byte) {
+    size_t count[256];
+    size_t offset[256];
+    while (n > SMALL_SORT_SIZE) {
+        if (byte == 8) {
+            // 前缀相同：已在前缀内结束的字符串只有长度不同，短的在前；其余在下一段前缀上继续排序
+            size_t end = depth + 8;
+            MStringSortKey* mid = std::partition(keys, keys + n, [end](const MStringSortKey& key) {
+                return key.len <= end;
+            });
+            std::sort(keys, mid, [](const MStringSortKey& a, const MStringSortKey& b) {
+                return a.len < b.len;
+            });
+            size_t rest = keys + n - mid;
+            for (size_t i = 0; i < rest; ++i) {
+                mid[i].prefix = loadPrefix(mid[i].data, mid[i].len, end);
+            }
+            temp += mid - keys;
+            keys = mid;
+            n = rest;
+            depth = end;
+            byte = 0;
+            continue;
+        }
+
+        int shift = 56 - 8 * byte;
+        std::fill(count, count + 256, 0);
+        for (size_t i = 0; i < n; ++i) {
+            count[(keys[i].prefix >> shift) & 0xFF]++;
+        }
+        ++byte;
+        // 只有一个桶时不需要移动
+        if (count[(keys[0].prefix >> shift) & 0xFF] == n) {
+            continue;
+        }
+        size_t sum = 0;
+        size_t largest = 0;
+        for (int b = 0; b < 256; ++b) {
+            offset[b] = sum;
+            sum += count[b];
+            if (count[b] > count[largest]) {
+                largest = b;
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            temp[offset[(keys[i].prefix >> shift) & 0xFF]++] = keys[i];
+        }
+        std::copy(temp, temp + n, keys);
+        size_t start = 0;
+        size_t largestStart = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            if (b == largest) {
+                largestStart = start;
+            } else if (count[b] > 1) {
+                radixSort(keys + start, temp + start, count[b], depth, byte);
+            }
+            start += count[b];
+        }
+        keys += largestStart;
+        temp += largestStart;
+        n = count[largest];
+    }
+    smallSort(keys, n, depth);
+}
+
+// 生成排序键
+static void buildKeys(const std::vector<MString>& strings, size_t begin, size_t end, MStringSortKey* keys) {
+    for (size_t i = begin; i < end; ++i) {
+        MStringSortKey& key = keys[i];
+        key.data = strings[i].getData();
+        key.len = strings[i].length();
+        key.prefix = loadPrefix(key.data, key.len, 0);
+        key.index = i;
+    }
+}
+
+// 按排序键的顺序移动字符串
+static void applyOrder(std::vector<MString>& strings, const std::vector<MStringSortKey>& keys, std::vector<MString>& sorted,
+                       size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        sorted[i] = std::move(strings[keys[i].index]);
+    }
+}
+
+// 批量排序
+void MString::sort(std::vector<MString>& strings) {
+    size_t n = strings.size();
+    if (n < 2) {
+        return;
+    }
+    std::vector<MStringSortKey> keys(n);
+    std::vector<MStringSortKey> temp(n);
+    buildKeys(strings, 0, n, keys.data());
+    radixSort(keys.data(), temp.data(), n, 0, 0);
+    std::vector<MString> sorted(n);
+    applyOrder(strings, keys, sorted, 0, n);
+    strings.swap(sorted);
+}
+
+// 多线程排序：各线程并行生成排序键并按分割点归类，按桶重排后各桶并行排序
+void MString::parallelSort(std::vector<MString>& strings, unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount > MAX_SORT_THREADS) {
+        threadCount = MAX_SORT_THREADS;
+    }
+    size_t n = strings.size();
+    if (threadCount <= 1 || n < PARALLEL_SORT_SIZE) {
+        sort(strings);
+        return;
+    }
+    const size_t buckets = threadCount;
+    std::vector<MStringSortKey> keys(n);
+    std::vector<MStringSortKey> temp(n);
+    auto runParallel = [threadCount](std::function<void(unsigned)> work) {
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < threadCount; ++t) {
+            threads.emplace_back(work, t);
+        }
+        work(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    // 等间隔采样并排序，取分割点
+    runParallel([&](unsigned t) {
+        buildKeys(strings, n * t / threadCount, n * (t + 1) / threadCount, keys.data());
+    });
+    const size_t oversample = 64;
+    std::vector<MStringSortKey> samples;
+    for (size_t i = 0; i < buckets * oversample; ++i) {
+        samples.push_back(keys[i * (n / (buckets * oversample))]);
+    }
+    smallSort(samples.data(), samples.size(), 0);
+    std::vector<MStringSortKey> splitters;
+    for (size_t b = 1; b < buckets; ++b) {
+        splitters.push_back(samples[b * oversample]);
+    }
+    auto less = [](const MStringSortKey& a, const MStringSortKey& b) {
+        return a.prefix != b.prefix ? a.prefix < b.prefix : tailLess(a, b, 8);
+    };
+
+    // 各线程归类自己的区间并统计各桶数量
+    std::vector<uint16_t> bucketOf(n);
+    std::vector<std::vector<size_t>> counts(threadCount, std::vector<size_t>(buckets, 0));
+    runParallel([&](unsigned t) {
+        for (size_t i = n * t / threadCount; i < n * (t + 1) / threadCount; ++i) {
+            size_t b = std::upper_bound(splitters.begin(), splitters.end(), keys[i], less) - splitters.begin();
+            bucketOf[i] = static_cast<uint16_t>(b);
+            counts[t][b]++;
+        }
+    });
+    std::vector<size_t> bucketStart(buckets + 1, 0);
+    std::vector<std::vector<size_t>> offsets(threadCount, std::vector<size_t>(buckets, 0));
+    size_t sum = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        bucketStart[b] = sum;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            offsets[t][b] = sum;
+            sum += counts[t][b];
+        }
+    }
+    bucketStart[buckets] = n;
+    runParallel([&](unsigned t) {
+        for (size_t i = n * t / threadCount; i < n * (t + 1) / threadCount; ++i) {
+            temp[offsets[t][bucketOf[i]]++] = keys[i];
+        }
+    });
+
+    // 各桶并行排序，再按顺序移动字符串
+    std::vector<MString> sorted(n);
+    runParallel([&](unsigned t) {
+        size_t begin = bucketStart[t];
+        size_t end = bucketStart[t + 1];
+        std::copy(temp.begin() + begin, temp.begin() + end, keys.begin() + begin);
+        radixSort(keys.data() + begin, temp.data() + begin, end - begin, 0, 0);
+        applyOrder(strings, keys, sorted, begin, end);
+    });
+    strings.swap(sorted);
+}
+
+// 去除相邻的重复项
+void MString::uniqueSorted(std::vector<MString>& sorted) {
+    auto last = std::unique(sorted.begin(), sorted.end(), [](const MString& a, const MString& b) {
+        return a.length() == b.length() && memcmp(a.getData(), b.getData(), a.length()) == 0;
+    });
+    sorted.erase(last, sorted.end());
+}
+
+// 多路归并：小顶堆中保存各序列当前元素的前缀，前缀不同时不需要比较字符串
+std::vector<MString> MString::mergeSorted(const std::vector<std::vector<MString>>& inputs) {
+    struct Head {
+        MStringSortKey key;// index为序列编号
+        size_t pos;// 在序列中的位置
+    };
+    auto greater = [](const Head& a, const Head& b) {
+        if (a.key.prefix != b.key.prefix) {
+            return a.key.prefix > b.key.prefix;
+        }
+        if (tailLess(b.key, a.key, 8)) {
+            return true;
+        }
+        return !tailLess(a.key, b.key, 8) && a.key.index > b.key.index;// 相等时保持输入序列的顺序
+    };
+    std::priority_queue<Head, std::vector<Head>, decltype(greater)> heap(greater);
+    size_t total = 0;
+    auto push = [&inputs, &heap](size_t input, size_t pos) {
+        const MString& str = inputs[input][pos];
+        Head head = { { loadPrefix(str.getData(), str.length(), 0), str.getData(), str.length(), input }, pos };
+        heap.push(head);
+    };
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        total += inputs[i].size();
+        if (!inputs[i].empty()) {
+            push(i, 0);
+        }
+    }
+
+    std::vector<MString> result;
+    result.reserve(total);
+    while (!heap.empty()) {
+        Head head = heap.top();
+        heap.pop();
+        result.push_back(inputs[head.key.index][head.pos]);
+        if (head.pos + 1 < inputs[head.key.index].size()) {
+            push(head.key.index, head.pos + 1);
+        }
+    }
+    return result;
+}
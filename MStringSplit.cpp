@@ -0,0 +1,63 @@
+#include "MStringSplit.h"
+#include "MStringSimd.h"
+
+// 构造函数：按单个字符分割
+MStringSplit::MStringSplit(MStringView text, char delimiter, bool keepEmpty)
+    : text_(text), delimiterChar_(delimiter), mode_(Mode::SPLIT_CHAR), keepEmpty_(keepEmpty) {
+}
+
+// 构造函数
+MStringSplit::MStringSplit(MStringView text, MStringView delimiter, Mode mode, bool keepEmpty)
+    : text_(text), delimiter_(delimiter), delimiterChar_(delimiter.isEmpty() ? '\0' : delimiter[0]), mode_(mode),
+      keepEmpty_(keepEmpty) {
+    if (delimiter_.isEmpty() && mode_ == Mode::SPLIT_CHAR) {
+        mode_ = Mode::SPLIT_STRING;// 空分隔符不分割
+    } else if (delimiter_.length() == 1) {
+        mode_ = Mode::SPLIT_CHAR;// 单字符分隔符统一使用memchr
+    }
+}
+
+// 收集全部字段
+std::vector<MStringView> MStringSplit::toVector() const {
+    std::vector<MStringView> tokens;
+    for (const auto& token : *this) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+// 查找下一个分隔符
+const char* MStringSplit::findDelimiter(const char* pos, size_t len, size_t& delimiterLen) const {
+    switch (mode_) {
+    case Mode::SPLIT_CHAR:
+        delimiterLen = 1;
+        return static_cast<const char*>(memchr(pos, delimiterChar_, len));
+    case Mode::SPLIT_STRING:
+        delimiterLen = delimiter_.length();
+        return MStringSimd::find(pos, len, delimiter_.data(), delimiter_.length());
+    case Mode::SPLIT_ANY_OF:
+    default:
+        delimiterLen = 1;
+        return MStringSimd::findAnyOf(pos, len, delimiter_.data(), delimiter_.length());
+    }
+}
+
+// 移动到下一个字段
+void MStringSplit::Iterator::advance() {
+    const char* end = split_->text_.end();
+    do {
+        if (next_ == nullptr) {
+            finished_ = true;
+            return;
+        }
+        size_t delimiterLen = 0;
+        const char* found = split_->findDelimiter(next_, end - next_, delimiterLen);
+        if (found != nullptr) {
+            token_ = MStringView(next_, found - next_);
+            next_ = found + delimiterLen;
+        } else {
+            token_ = MStringView(next_, end - next_);
+            next_ = nullptr;
+        }
+    } while (!split_->keepEmpty_ && token_.isEmpty());
+}
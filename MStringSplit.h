@@ -0,0 +1,99 @@
+#ifndef MSTRINGSPLIT_H
+#define MSTRINGSPLIT_H
+
+#include <iterator>
+#include <vector>
+#include "MStringView.h"
+
+// 延迟分割区间：遍历时逐个查找分隔符并返回视图，不修改原字符串、不分配内存
+// 区间和产生的视图都引用原字符串，使用期间原字符串必须保持有效
+//   for (MStringView token : str.view().splitBy(',')) { ... }
+class MStringSplit {
+public:
+    enum class Mode {// 分隔符类型
+        SPLIT_CHAR,// 单个字符
+        SPLIT_STRING,// 完整字符串
+        SPLIT_ANY_OF// 字符集合中的任一字符
+    };
+
+    // 前向迭代器
+    class Iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef MStringView value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const MStringView* pointer;
+        typedef const MStringView& reference;
+
+        Iterator() : split_(nullptr), next_(nullptr), finished_(true) {}
+
+        const MStringView& operator*() const {
+            return token_;
+        }
+
+        const MStringView* operator->() const {
+            return &token_;
+        }
+
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            advance();
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return finished_ == other.finished_ && (finished_ || token_.data() == other.token_.data());
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    private:
+        friend class MStringSplit;
+
+        const MStringSplit* split_;// 所属区间
+        const char* next_;// 下一个字段的起始位置，nullptr表示已到达最后一个字段
+        MStringView token_;// 当前字段
+        bool finished_;// 是否已遍历结束
+
+        explicit Iterator(const MStringSplit* split) : split_(split), next_(split->text_.data()), finished_(false) {
+            advance();
+        }
+
+        // 移动到下一个字段
+        void advance();
+    };
+
+    // 构造函数：按单个字符分割
+    MStringSplit(MStringView text, char delimiter, bool keepEmpty);
+
+    // 构造函数：分隔符为空时整个字符串作为一个字段
+    MStringSplit(MStringView text, MStringView delimiter, Mode mode, bool keepEmpty);
+
+    Iterator begin() const {
+        return Iterator(this);
+    }
+
+    Iterator end() const {
+        return Iterator();
+    }
+
+    // 收集全部字段
+    std::vector<MStringView> toVector() const;
+private:
+    MStringView text_;// 被分割的字符串
+    MStringView delimiter_;// 分隔符或字符集合
+    char delimiterChar_;// SPLIT_CHAR模式的分隔符
+    Mode mode_;// 分隔符类型
+    bool keepEmpty_;// 是否保留空字段
+
+    // 查找下一个分隔符，返回其位置和长度，未找到返回nullptr
+    const char* findDelimiter(const char* pos, size_t len, size_t& delimiterLen) const;
+};
+
+#endif //MSTRINGSPLIT_H
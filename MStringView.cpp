@@ -0,0 +1,123 @@
+#include "MStringView.h"
+#include "MStringSimd.h"
+#include <cctype>
+
+const size_t MStringView::npos;
+
+// 去除首尾空白字符
+MStringView MStringView::trim() const {
+    const char* start = data_;
+    const char* end = data_ + len_;
+    while (start < end && isspace(static_cast<unsigned char>(*start))) start++;
+    while (end > start && isspace(static_cast<unsigned char>(*(end - 1)))) end--;
+    return MStringView(start, end - start);
+}
+
+// UTF-8码点数
+size_t MStringView::codePointLength() const {
+    return MStringSimd::countCodePoints(data_, len_);
+}
+
+// 第index个码点的字节偏移
+size_t MStringView::codePointOffset(size_t index) const {
+    return MStringSimd::codePointOffset(data_, len_, index);
+}
+
+// 按码点截取，开头不属于任何码点的后续字节归入第0个码点
+MStringView MStringView::codePointMid(size_t pos, size_t n) const {
+    size_t start = pos == 0 ? 0 : MStringSimd::codePointOffset(data_, len_, pos);
+    size_t end = start + MStringSimd::codePointOffset(data_ + start, len_ - start, n);
+    return MStringView(data_ + start, end - start);
+}
+
+// 按码点返回右侧的n个码点：从末尾向前计数
+MStringView MStringView::codePointRight(size_t n) const {
+    size_t pos = len_;
+    for (size_t count = 0; pos > 0 && count < n;) {
+        --pos;
+        count += (static_cast<unsigned char>(data_[pos]) & 0xC0) != 0x80;
+    }
+    return MStringView(data_ + pos, len_ - pos);
+}
+
+// 按码点遍历
+MStringCodePoints MStringView::codePoints() const {
+    return MStringCodePoints(*this);
+}
+
+// 查找子字符串并返回开始位置，未找到返回-1
+int MStringView::find(MStringView substr, size_t startPos) const {
+    if (startPos >= len_) {
+        return -1;  // 起始位置无效
+    }
+    const char* pos = MStringSimd::find(data_ + startPos, len_ - startPos, substr.data_, substr.len_);
+    return pos ? static_cast<int>(pos - data_) : -1;
+}
+
+// 反向查找子字符串并返回开始位置，匹配结果的最后一个字符不超过startPos
+int MStringView::rfind(MStringView substr, size_t startPos) const {
+    if (len_ == 0) {
+        return -1;
+    }
+
+    // 默认从字符串末尾开始查找
+    if (startPos >= len_) {
+        startPos = len_ - 1;
+    }
+    const char* pos = MStringSimd::rfind(data_, startPos + 1, substr.data_, substr.len_);
+    return pos ? static_cast<int>(pos - data_) : -1;
+}
+
+// 字符串比较（按无符号字节序，与strcmp一致）
+int MStringView::compareTo(MStringView other) const {
+    size_t n = len_ < other.len_ ? len_ : other.len_;
+    int res = memcmp(data_, other.data_, n);
+    if (res != 0) {
+        return res;
+    }
+    return (len_ < other.len_) ? -1 : (len_ > other.len_ ? 1 : 0);
+}
+
+// 忽略ASCII大小写比较，逐字节转换大小写而不生成副本
+int MStringView::compareIgnoreCase(MStringView other) const {
+    size_t n = len_ < other.len_ ? len_ : other.len_;
+    int res = MStringSimd::compareIgnoreCase(data_, other.data_, n);
+    if (res != 0) {
+        return res;
+    }
+    return (len_ < other.len_) ? -1 : (len_ > other.len_ ? 1 : 0);
+}
+
+// 忽略ASCII大小写判断是否相等
+bool MStringView::equalsIgnoreCase(MStringView other) const {
+    return len_ == other.len_ && MStringSimd::compareIgnoreCase(data_, other.data_, len_) == 0;
+}
+
+// 忽略ASCII大小写查找子字符串
+int MStringView::findIgnoreCase(MStringView substr, size_t startPos) const {
+    if (startPos >= len_) {
+        return -1;  // 起始位置无效
+    }
+    const char* pos = MStringSimd::findIgnoreCase(data_ + startPos, len_ - startPos, substr.data_, substr.len_);
+    return pos ? static_cast<int>(pos - data_) : -1;
+}
+
+// 字符串分割：delimiter中的任一字符均为分隔符，忽略空字段（与strtok一致）
+std::vector<MStringView> MStringView::split(MStringView delimiter) const {
+    return splitAnyOf(delimiter, false).toVector();
+}
+
+// 延迟分割：按单个字符分割
+MStringSplit MStringView::splitBy(char delimiter, bool keepEmpty) const {
+    return MStringSplit(*this, delimiter, keepEmpty);
+}
+
+// 延迟分割：按完整字符串分割
+MStringSplit MStringView::splitBy(MStringView delimiter, bool keepEmpty) const {
+    return MStringSplit(*this, delimiter, MStringSplit::Mode::SPLIT_STRING, keepEmpty);
+}
+
+// 延迟分割：chars中的任一字符均为分隔符
+MStringSplit MStringView::splitAnyOf(MStringView chars, bool keepEmpty) const {
+    return MStringSplit(*this, chars, MStringSplit::Mode::SPLIT_ANY_OF, keepEmpty);
+}
@@ -0,0 +1,162 @@
+#ifndef MSTRINGVIEW_H
+#define MSTRINGVIEW_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ostream>
+
+class MStringSplit;
+class MStringCodePoints;
+
+// 非拥有的字符串视图（指针 + 长度），不保证以'\0'结尾
+// 视图不管理内存，使用期间被引用的字符串必须保持有效
+class MStringView {
+private:
+    const char* data_;// 数据起始位置
+    size_t len_;// 数据长度
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    // 构造函数
+    MStringView() : data_(""), len_(0) {}
+
+    // 构造函数
+    MStringView(const char* s) : data_(s ? s : ""), len_(s ? strlen(s) : 0) {}
+
+    // 构造函数：指定长度
+    MStringView(const char* s, size_t len) : data_(s), len_(len) {}
+
+    // 构造函数
+    MStringView(const std::string& s) : data_(s.data()), len_(s.size()) {}
+
+    // 数据起始位置
+    const char* data() const {
+        return data_;
+    }
+
+    // 获取长度
+    size_t length() const {
+        return len_;
+    }
+
+    // 判断是否为空
+    bool isEmpty() const {
+        return len_ == 0;
+    }
+
+    // 下标访问
+    char operator[](size_t i) const {
+        return data_[i];
+    }
+
+    const char* begin() const {
+        return data_;
+    }
+
+    const char* end() const {
+        return data_ + len_;
+    }
+
+    // 返回从指定位置开始的指定数量的字符
+    MStringView mid(size_t pos, size_t n) const {
+        if (pos > len_) {
+            return MStringView();
+        }
+        return MStringView(data_ + pos, (n > len_ - pos) ? len_ - pos : n);
+    }
+
+    // 返回左侧的指定数量的字符
+    MStringView left(size_t n) const {
+        return mid(0, n);
+    }
+
+    // 返回右侧的指定数量的字符
+    MStringView right(size_t n) const {
+        return (n > len_) ? *this : MStringView(data_ + len_ - n, n);
+    }
+
+    // UTF-8码点数：统计非后续字节，只对合法的UTF-8与codePoints()遍历的个数一致
+    // 非法序列的计数与截取位置没有定义，例如"\xE4\xBD" "a\x80\x80" "b"计为3个，遍历得到6个
+    size_t codePointLength() const;
+
+    // 第index个码点的字节偏移，超出时返回length()
+    size_t codePointOffset(size_t index) const;
+
+    // 按码点返回从第pos个码点开始的n个码点，不会截断多字节字符
+    // 需要反复随机访问时使用 MStringCodePointIndex 避免每次从头计数
+    MStringView codePointMid(size_t pos, size_t n) const;
+
+    // 按码点返回左侧的n个码点
+    MStringView codePointLeft(size_t n) const {
+        return codePointMid(0, n);
+    }
+
+    // 按码点返回右侧的n个码点
+    MStringView codePointRight(size_t n) const;
+
+    // 按码点遍历
+    MStringCodePoints codePoints() const;
+
+    // 去除首尾空白字符
+    MStringView trim() const;
+
+    // 查找子字符串并返回开始位置，未找到返回-1
+    int find(MStringView substr, size_t startPos = 0) const;
+
+    // 反向查找子字符串并返回开始位置，匹配结果的最后一个字符不超过startPos
+    int rfind(MStringView substr, size_t startPos = npos) const;
+
+    // 判断是否存在字串
+    bool contains(MStringView substr) const {
+        return find(substr) != -1;
+    }
+
+    // 字符串比较（按无符号字节序，与strcmp一致）
+    int compareTo(MStringView other) const;
+
+    // 忽略ASCII大小写比较（按小写后的无符号字节序）
+    int compareIgnoreCase(MStringView other) const;
+
+    // 忽略ASCII大小写判断是否相等
+    bool equalsIgnoreCase(MStringView other) const;
+
+    // 忽略ASCII大小写查找子字符串并返回开始位置，未找到返回-1
+    int findIgnoreCase(MStringView substr, size_t startPos = 0) const;
+
+    // 字符串分割：delimiter中的任一字符均为分隔符，忽略空字段（与strtok一致）
+    std::vector<MStringView> split(MStringView delimiter) const;
+
+    // 延迟分割：按单个字符分割
+    MStringSplit splitBy(char delimiter, bool keepEmpty = true) const;
+
+    // 延迟分割：按完整字符串分割
+    MStringSplit splitBy(MStringView delimiter, bool keepEmpty = true) const;
+
+    // 延迟分割：chars中的任一字符均为分隔符
+    MStringSplit splitAnyOf(MStringView chars, bool keepEmpty = true) const;
+
+    // 转换为 std::string
+    std::string toStdString() const {
+        return std::string(data_, len_);
+    }
+
+    bool operator==(MStringView other) const {
+        return len_ == other.len_ && memcmp(data_, other.data_, len_) == 0;
+    }
+
+    bool operator!=(MStringView other) const {
+        return !(*this == other);
+    }
+
+    // 输出运算符重载
+    friend std::ostream& operator<<(std::ostream& os, MStringView view) {
+        return os.write(view.data_, view.len_);
+    }
+};
+
+// MStringSplit、MStringCodePoints依赖完整的MStringView定义，放在类定义之后引入
+#include "MStringSplit.h"
+#include "MStringCodePoint.h"
+
+#endif //MSTRINGVIEW_H
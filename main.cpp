@@ -1,15 +1,102 @@
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
 #include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <new>
 #include <fstream>
 #include <iostream>
 #include <functional>
+#include <algorithm>
 #include <unordered_map>
 #include "MString.h"
+#include "MStringBuilder.h"
+#include "MStringSearcher.h"
+#include "MStringMatcher.h"
+#include "MStringFormat.h"
+#include "MStringEncoding.h"
+#include "MStringCodec.h"
+#include "MStringIntern.h"
+#include "MStringMappedFile.h"
+#include "MStringRope.h"
 #include "ClubMember.h"
 #include "Logger.h"
 #include "SLogger.hpp"
 
+// 堆分配计数（替换全局operator new/delete的全部形式），用于统计MString的分配次数
+static std::atomic<uint64_t> g_allocCount(0);
+
+// 分配与释放函数不内联：内联后编译器会把调用方的operator new与此处的free视为不匹配（-Wmismatched-new-delete）
+#if defined(__GNUC__)
+#define ALLOC_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define ALLOC_NOINLINE __declspec(noinline)
+#else
+#define ALLOC_NOINLINE
+#endif
+
+ALLOC_NOINLINE static void* countedAlloc(size_t size) noexcept {
+	g_allocCount++;
+	return malloc(size == 0 ? 1 : size);
+}
+
+ALLOC_NOINLINE static void countedFree(void* ptr) noexcept {
+	free(ptr);
+}
+
+ALLOC_NOINLINE void* operator new(size_t size) {
+	void* ptr = countedAlloc(size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+ALLOC_NOINLINE void* operator new[](size_t size) {
+	void* ptr = countedAlloc(size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+ALLOC_NOINLINE void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return countedAlloc(size);
+}
+
+ALLOC_NOINLINE void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return countedAlloc(size);
+}
+
+ALLOC_NOINLINE void operator delete(void* ptr) noexcept {
+	countedFree(ptr);
+}
+
+ALLOC_NOINLINE void operator delete[](void* ptr) noexcept {
+	countedFree(ptr);
+}
+
+ALLOC_NOINLINE void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	countedFree(ptr);
+}
+
+ALLOC_NOINLINE void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	countedFree(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+ALLOC_NOINLINE void operator delete(void* ptr, size_t) noexcept {
+	countedFree(ptr);
+}
+
+ALLOC_NOINLINE void operator delete[](void* ptr, size_t) noexcept {
+	countedFree(ptr);
+}
+#endif
+
 void MStringFullTest() {
 	// 创建成员
 	ClubMember zcc(1, "congcong.zhang", 18, "hedong, tianjin", "28810331651");
@@ -151,12 +238,917 @@ void loggerPerformanceTest() {
 //	}
 }
 
+// MStringFullTest的堆分配次数与吞吐量测试（关闭控制台输出）
+void MStringAllocationTest(uint64_t count = 100000) {
+	std::streambuf* coutBuf = std::cout.rdbuf(nullptr);
+
+	uint64_t allocBefore = g_allocCount;
+	MStringFullTest();
+	uint64_t allocCount = g_allocCount - allocBefore;
+
+	uint64_t startTime = getCurrentTimeMillis();
+	for (uint64_t i = 0; i < count; ++i) {
+		MStringFullTest();
+	}
+	uint64_t stopTime = getCurrentTimeMillis();
+
+	std::cout.rdbuf(coutBuf);
+	std::cout.clear();
+	uint64_t costTime = stopTime > startTime ? stopTime - startTime : 1;
+	std::cout << MString::format("MStringFullTest: {} allocations per run | {} runs takes {} milliseconds | {} runs per second",
+	                             allocCount, count, costTime, count * 1000 / costTime) << std::endl;
+}
+
+// 追加性能测试：MString += 与 MStringBuilder（每次构建由appendCount次追加组成）
+void stringAppendPerformanceTest(int appendCount = 10000) {
+	std::cout << "MString +=: ";
+	auto plusLambda = [appendCount]() {
+		MString addr;
+		for (int i = 0; i < appendCount; ++i) {
+			addr += ", china ";
+		}
+		return addr;
+	};
+	performanceTest(plusLambda, 1000);
+
+	std::cout << "MStringBuilder: ";
+	auto builderLambda = [appendCount]() {
+		MStringBuilder builder;
+		for (int i = 0; i < appendCount; ++i) {
+			builder.append(", china ");
+		}
+		return builder.build();
+	};
+	performanceTest(builderLambda, 1000);
+}
+
+// 子串查找性能测试：MString 与 std::string::find、memmem 对比
+void stringSearchPerformanceTest() {
+	static volatile size_t sink = 0;// 防止查找结果被优化掉
+
+	// 10万条会员地址
+	const char* cities[] = { "hedong, tianjin", "yubei, chongqing", "yuanyang, henan", "chaoyang, beijing" };
+	std::vector<MString> addrs;
+	std::vector<std::string> stdAddrs;
+	for (int i = 0; i < 100000; ++i) {
+		addrs.push_back(MString::format("No.{} renmin road, {}", i, cities[i % 4]));
+		stdAddrs.push_back(addrs.back().toStdString());
+	}
+
+	std::cout << "MString::contains over addresses: ";
+	performanceTest([&addrs]() {
+		for (const auto& addr : addrs) {
+			sink += addr.contains("yuanyang");
+		}
+	}, 100);
+	std::cout << "MStringSearcher::contains over addresses: ";
+	MStringSearcher searcher("yuanyang");
+	performanceTest([&addrs, &searcher]() {
+		for (const auto& addr : addrs) {
+			sink += searcher.contains(addr);
+		}
+	}, 100);
+	std::cout << "std::string::find over addresses: ";
+	performanceTest([&stdAddrs]() {
+		for (const auto& addr : stdAddrs) {
+			sink += addr.find("yuanyang") != std::string::npos;
+		}
+	}, 100);
+#ifndef _WIN32
+	std::cout << "memmem over addresses: ";
+	performanceTest([&stdAddrs]() {
+		for (const auto& addr : stdAddrs) {
+			sink += memmem(addr.data(), addr.size(), "yuanyang", 8) != nullptr;
+		}
+	}, 100);
+#endif
+
+	// 1MB文本，目标在末尾
+	std::string text(1024 * 1024, 'y');
+	text += "yuanyang";
+	MString mtext = MString::fromStdString(text);
+	std::cout << "MString::find over 1MB: ";
+	performanceTest([&mtext]() {
+		sink += mtext.find("yuanyang");
+	}, 1000);
+	std::cout << "MString::rfind over 1MB: ";
+	performanceTest([&mtext]() {
+		sink += mtext.rfind("nonexistent");
+	}, 1000);
+	std::cout << "std::string::find over 1MB: ";
+	performanceTest([&text]() {
+		sink += text.find("yuanyang");
+	}, 1000);
+#ifndef _WIN32
+	std::cout << "memmem over 1MB: ";
+	performanceTest([&text]() {
+		sink += static_cast<const char*>(memmem(text.data(), text.size(), "yuanyang", 8)) - text.data();
+	}, 1000);
+#endif
+}
+
+// 多关键字匹配性能测试：逐个 contains 与 MStringMatcher 对比
+void stringMatcherPerformanceTest(int keywordCount = 200) {
+	static volatile size_t sink = 0;
+
+	// 10万条会员地址，200个屏蔽关键字
+	const char* cities[] = { "hedong, tianjin", "yubei, chongqing", "yuanyang, henan", "chaoyang, beijing" };
+	std::vector<MString> addrs;
+	for (int i = 0; i < 100000; ++i) {
+		addrs.push_back(MString::format("No.{} renmin road, {}", i, cities[i % 4]));
+	}
+	std::vector<MString> keywords;
+	for (int i = 0; i < keywordCount; ++i) {
+		keywords.push_back(MString::format("blocked-{}", i));
+	}
+	keywords.push_back("yuanyang");
+
+	std::cout << "MString::contains per keyword: ";
+	performanceTest([&addrs, &keywords]() {
+		for (const auto& addr : addrs) {
+			for (const auto& keyword : keywords) {
+				if (addr.contains(keyword)) {
+					sink += 1;
+					break;
+				}
+			}
+		}
+	}, 10);
+	std::cout << "MStringMatcher::containsAny: ";
+	MStringMatcher matcher(keywords);
+	performanceTest([&addrs, &matcher]() {
+		for (const auto& addr : addrs) {
+			sink += matcher.containsAny(addr);
+		}
+	}, 10);
+}
+
+// 字符串替换性能测试：MString::replace 与 std::string 循环替换对比
+void stringReplacePerformanceTest() {
+	static volatile size_t sink = 0;
+
+	// 64KB文本，约2000处匹配
+	MString text;
+	for (int i = 0; i < 2000; ++i) {
+		text += "No.1 renmin road, china; ";
+	}
+	std::string stdText = text.toStdString();
+
+	std::cout << "MString::replace: ";
+	performanceTest([&text]() {
+		sink += text.replace("china", "america").length();
+	}, 1000);
+	std::cout << "std::string replace loop: ";
+	performanceTest([&stdText]() {
+		std::string result = stdText;
+		size_t pos = 0;
+		while ((pos = result.find("china", pos)) != std::string::npos) {
+			result.replace(pos, 5, "america");
+			pos += 7;
+		}
+		sink += result.size();
+	}, 1000);
+	std::cout << "MString::replace with map: ";
+	performanceTest([&text]() {
+		sink += text.replace({ { "china", "america" }, { "renmin", "people" }, { "road", "street" } }).length();
+	}, 1000);
+}
+
+// 字符串分割性能测试：split 与延迟分割对比
+void stringSplitPerformanceTest() {
+	static volatile size_t sink = 0;
+
+	// 1万个字段的CSV行
+	MString line;
+	for (int i = 0; i < 10000; ++i) {
+		line += MString::format("field{},", i);
+	}
+
+	std::cout << "MString::split: ";
+	performanceTest([&line]() {
+		sink += line.split(",").size();
+	}, 1000);
+	std::cout << "MStringView::splitBy: ";
+	performanceTest([&line]() {
+		for (const auto& token : line.view().splitBy(',')) {
+			sink += token.length();
+		}
+	}, 1000);
+	std::cout << "MStringView::splitAnyOf: ";
+	performanceTest([&line]() {
+		for (const auto& token : line.view().splitAnyOf(",;\t")) {
+			sink += token.length();
+		}
+	}, 1000);
+}
+
+// 大小写转换性能测试：逐字节std::toupper/std::tolower 与 SIMD 对比
+void caseConvertPerformanceTest() {
+	static volatile size_t sink = 0;
+
+	// 约64KB的混合大小写文本
+	MString text;
+	for (int i = 0; i < 2000; ++i) {
+		text += MString::format("Hello World {} MString Case Test, ", i);
+	}
+	text += "NEEDLE in the Haystack";
+
+	std::cout << "std::toupper per byte: ";
+	performanceTest([&text]() {
+		std::string upper(text.getData(), text.length());
+		for (auto& c : upper) {
+			c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+		}
+		sink += upper.size();
+	}, 10000);
+	std::cout << "MString::toUpperCase: ";
+	performanceTest([&text]() {
+		sink += text.toUpperCase().length();
+	}, 10000);
+	std::cout << "MString::makeLowerCase: ";
+	MString copy = text;
+	performanceTest([&copy]() {
+		sink += copy.makeLowerCase().length();
+	}, 10000);
+	std::cout << "toLowerCase + find: ";
+	performanceTest([&text]() {
+		sink += text.toLowerCase().find("needle in the haystack");
+	}, 10000);
+	std::cout << "MString::findIgnoreCase: ";
+	performanceTest([&text]() {
+		sink += text.findIgnoreCase("needle in the haystack");
+	}, 10000);
+	std::cout << "MString::equalsIgnoreCase: ";
+	MString other = text.toUpperCase();
+	performanceTest([&text, &other]() {
+		sink += text.equalsIgnoreCase(other);
+	}, 10000);
+}
+
+// UTF-8校验与编码检测性能测试：每次处理1MB数据
+void utf8ValidatePerformanceTest() {
+	static volatile size_t sink = 0;
+
+	// 约1MB的中英文混合文本与纯ASCII文本
+	MString mixed;
+	while (mixed.length() < 1024 * 1024) {
+		mixed += "UTF-8\xE6\xA0\xA1\xE9\xAA\x8C\xE6\x80\xA7\xE8\x83\xBD\xE6\xB5\x8B\xE8\xAF\x95 performance test, ";
+	}
+	const std::string asciiText(mixed.length(), 'a');
+	MString ascii(asciiText.data(), asciiText.size());
+
+	std::cout << "MString::isUtf8Encoding(ASCII 1MB): ";
+	performanceTest([&ascii]() {
+		sink += MString::isUtf8Encoding(ascii.getData(), ascii.length());
+	}, 1000);
+	std::cout << "MString::isUtf8Encoding(mixed 1MB): ";
+	performanceTest([&mixed]() {
+		sink += MString::isUtf8Encoding(mixed.getData(), mixed.length());
+	}, 1000);
+	std::cout << "MStringEncodingDetector(mixed 1MB, 4KB chunks): ";
+	performanceTest([&mixed]() {
+		MStringEncodingDetector detector;
+		for (size_t pos = 0; pos < mixed.length(); pos += 4096) {
+			size_t len = mixed.length() - pos < 4096 ? mixed.length() - pos : 4096;
+			detector.update(mixed.getData() + pos, len);
+		}
+		sink += detector.result();
+	}, 1000);
+}
+
+// 编码转换性能测试：约1MB中英文混合文本在GBK、UTF-8、UTF-16之间转换
+void encodingConvertPerformanceTest() {
+	static volatile size_t sink = 0;
+
+	MString utf8;
+	while (utf8.length() < 1024 * 1024) {
+		utf8 += "你好，世界 hello world 12345, ";
+	}
+	MString gbk = utf8.utf8ToGbk();
+	MString utf16;
+	MString::convertEncoding(utf8, StringEncoding_UTF8, StringEncoding_UTF16_LE, utf16);
+	std::vector<char> output(MStringConverter::maxOutputLength(StringEncoding_UTF8, StringEncoding_UTF16_LE, utf8.length()));
+
+	std::cout << "MStringConverter GBK -> UTF-8: ";
+	performanceTest([&gbk, &output]() {
+		sink += MStringConverter::convert(StringEncoding_ANSI, StringEncoding_UTF8, gbk.getData(), gbk.length(), output.data(), output.size()).written;
+	}, 1000);
+	std::cout << "MStringConverter UTF-8 -> GBK: ";
+	performanceTest([&utf8, &output]() {
+		sink += MStringConverter::convert(StringEncoding_UTF8, StringEncoding_ANSI, utf8.getData(), utf8.length(), output.data(), output.size()).written;
+	}, 1000);
+	std::cout << "MStringConverter UTF-8 -> UTF-16LE: ";
+	performanceTest([&utf8, &output]() {
+		sink += MStringConverter::convert(StringEncoding_UTF8, StringEncoding_UTF16_LE, utf8.getData(), utf8.length(), output.data(), output.size()).written;
+	}, 1000);
+	std::cout << "MStringConverter UTF-16LE -> UTF-8: ";
+	performanceTest([&utf16, &output]() {
+		sink += MStringConverter::convert(StringEncoding_UTF16_LE, StringEncoding_UTF8, utf16.getData(), utf16.length(), output.data(), output.size()).written;
+	}, 1000);
+	std::cout << "MString::gbkToUtf8: ";
+	performanceTest([&gbk]() {
+		sink += gbk.gbkToUtf8().length();
+	}, 1000);
+}
+
+// 码点操作性能测试：逐字节计数与SIMD计数、逐次从头截取与码点索引对比
+void codePointPerformanceTest() {
+	static volatile size_t sink = 0;
+
+	MString text;
+	while (text.length() < 1024 * 1024) {
+		text += "会员张三丰 member No.12345, 地址：深圳市南山区; ";
+	}
+
+	std::cout << "byte loop codePointLength(1MB): ";
+	performanceTest([&text]() {
+		size_t count = 0;
+		for (char c : text) {
+			count += (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+		}
+		sink += count;
+	}, 1000);
+	std::cout << "MString::codePointLength(1MB): ";
+	performanceTest([&text]() {
+		sink += text.codePointLength();
+	}, 1000);
+
+	const size_t total = text.codePointLength();
+	std::cout << "MStringView::codePointMid x1000: ";
+	performanceTest([&text, total]() {
+		for (size_t i = 0; i < 1000; ++i) {
+			sink += text.view().codePointMid(i * 7919 % total, 8).length();
+		}
+	}, 100);
+	std::cout << "MStringCodePointIndex::mid x1000: ";
+	MStringCodePointIndex index(text.view());
+	performanceTest([&index, total]() {
+		for (size_t i = 0; i < 1000; ++i) {
+			sink += index.mid(i * 7919 % total, 8).length();
+		}
+	}, 100);
+}
+
+// 十六进制/Base64编解码性能测试：逐字节拼接与MStringCodec对比（4MB二进制数据）
+void binaryCodecPerformanceTest() {
+	static volatile size_t sink = 0;
+
+	MString data;
+	data.reserve(4 * 1024 * 1024);
+	unsigned seed = 12345;
+	while (data.length() < 4 * 1024 * 1024) {
+		seed = seed * 1103515245 + 12345;
+		data += static_cast<char>(seed >> 16);
+	}
+	MString hex = data.toHex();
+	MString base64 = data.toBase64();
+	std::vector<char> output(MStringCodec::hexEncodedLength(data.length(), 1));
+
+	std::cout << "byte loop hex encode: ";
+	performanceTest([&data, &output]() {
+		static const char* hexChars = "0123456789ABCDEF";
+		char* out = output.data();
+		for (char c : data) {
+			unsigned char byte = static_cast<unsigned char>(c);
+			*out++ = hexChars[byte >> 4];
+			*out++ = hexChars[byte & 0x0F];
+		}
+		sink += out - output.data();
+	}, 100);
+	std::cout << "MStringCodec hex encode: ";
+	performanceTest([&data, &output]() {
+		sink += MStringCodec::hexEncode(output.data(), data.getData(), data.length());
+	}, 100);
+	std::cout << "MString::getHexString: ";
+	performanceTest([&data]() {
+		sink += data.getHexString().length();
+	}, 100);
+	std::cout << "byte loop hex decode: ";
+	performanceTest([&hex, &output]() {
+		const char* in = hex.getData();
+		for (size_t i = 0; i < hex.length() / 2; ++i) {
+			char pair[3] = { in[2 * i], in[2 * i + 1], '\0' };
+			output[i] = static_cast<char>(strtol(pair, nullptr, 16));
+		}
+		sink += hex.length() / 2;
+	}, 10);
+	std::cout << "MStringCodec hex decode: ";
+	performanceTest([&hex, &output]() {
+		sink += MStringCodec::hexDecode(hex.getData(), hex.length(), output.data(), output.size()).written;
+	}, 100);
+	std::cout << "MStringCodec base64 encode: ";
+	performanceTest([&data, &output]() {
+		sink += MStringCodec::base64Encode(output.data(), data.getData(), data.length());
+	}, 100);
+	std::cout << "MStringCodec base64 decode: ";
+	performanceTest([&base64, &output]() {
+		sink += MStringCodec::base64Decode(base64.getData(), base64.length(), output.data(), output.size()).written;
+	}, 100);
+}
+
+// 分配器性能测试：每次请求构建500个临时字符串，对比默认堆、单调分配器与分级内存池的堆分配次数和吞吐量
+void allocatorPerformanceTest() {
+	static volatile size_t sink = 0;
+	std::vector<MString> strings;
+	strings.reserve(500);
+	MStringArena arena;
+	MStringPool pool;
+
+	auto request = [&strings](MStringAllocator* allocator) {
+		for (int i = 0; i < 500; ++i) {
+			MString str("request-member-record:", allocator);
+			str.append(i);
+			str += " name=zhangsanfeng address=shenzhen-nanshan";
+			strings.push_back(std::move(str));
+		}
+		sink += strings.size();
+		strings.clear();
+	};
+	auto test = [&request](const char* name, MStringAllocator* allocator, std::function<void()> done) {
+		uint64_t allocBefore = g_allocCount;
+		request(allocator);
+		done();
+		std::cout << name << ": " << (g_allocCount - allocBefore) << " allocations per request | ";
+		performanceTest([&request, allocator, &done]() {
+			request(allocator);
+			done();
+		}, 10000);
+	};
+
+	test("default heap", nullptr, []() {});
+	test("MStringArena", &arena, [&arena]() { arena.reset(); });
+	test("MStringPool", &pool, []() {});
+}
+
+// 字符串驻留性能测试：8个线程驻留重复的地址，对比单锁哈希表与分片驻留池；相等比较对比strcmp与句柄比较
+void internPerformanceTest() {
+	static volatile size_t sink = 0;
+	const int threadCount = 8;
+	const int perThread = 200000;
+
+	std::vector<MString> addrs;
+	for (int i = 0; i < 1000; ++i) {
+		addrs.push_back(MString::format("广东省深圳市南山区科技园路{}号", i));
+	}
+
+	auto runThreads = [&](std::function<void(int)> work) {
+		uint64_t startTime = getCurrentTimeMillis();
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back(work, t);
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		std::cout << MString::format("{} threads x {} strings takes {} milliseconds", threadCount, perThread,
+		                             getCurrentTimeMillis() - startTime) << std::endl;
+	};
+
+	std::mutex mutex;
+	std::unordered_map<std::string, int> table;
+	std::cout << "single mutex unordered_map: ";
+	runThreads([&](int t) {
+		for (int i = 0; i < perThread; ++i) {
+			const MString& addr = addrs[(i * 7 + t) % addrs.size()];
+			std::lock_guard<std::mutex> lock(mutex);
+			sink += table.emplace(std::string(addr.getData(), addr.length()), i).first->second;
+		}
+	});
+
+	MStringInternPool pool;
+	std::cout << "MStringInternPool: ";
+	runThreads([&](int t) {
+		for (int i = 0; i < perThread; ++i) {
+			sink += pool.intern(addrs[(i * 7 + t) % addrs.size()]).length();
+		}
+	});
+
+	// 100万条记录的地址：各自分配的MString与驻留句柄
+	std::vector<MString> records;
+	std::vector<MStringAtom> atoms;
+	uint64_t allocBefore = g_allocCount;
+	for (int i = 0; i < 1000000; ++i) {
+		records.push_back(addrs[i % addrs.size()]);
+	}
+	std::cout << "MString records: " << (g_allocCount - allocBefore) << " allocations | ";
+	allocBefore = g_allocCount;
+	for (int i = 0; i < 1000000; ++i) {
+		atoms.push_back(pool.intern(addrs[i % addrs.size()]));
+	}
+	std::cout << "MStringAtom records: " << (g_allocCount - allocBefore) << " allocations" << std::endl;
+
+	std::cout << "MString operator== : ";
+	performanceTest([&records]() {
+		size_t equal = 0;
+		for (size_t i = 1; i < records.size(); ++i) {
+			equal += records[i] == records[i - 1];
+		}
+		sink += equal;
+	}, 10);
+	std::cout << "MStringAtom operator== : ";
+	performanceTest([&atoms]() {
+		size_t equal = 0;
+		for (size_t i = 1; i < atoms.size(); ++i) {
+			equal += atoms[i] == atoms[i - 1];
+		}
+		sink += equal;
+	}, 10);
+}
+
+// 哈希表性能测试：10万个键插入，再以const char*查找100万次，对比std::string、MString与缓存哈希值的MStringKey
+void hashMapPerformanceTest() {
+	static volatile size_t sink = 0;
+	const int keyCount = 100000;
+
+	std::vector<MString> keys;
+	for (int i = 0; i < keyCount; ++i) {
+		keys.push_back(MString::format("member:{}:shenzhen-nanshan-district", i * 7919));
+	}
+	std::vector<const char*> lookups;
+	for (int i = 0; i < 1000000; ++i) {
+		lookups.push_back(keys[(i * 31) % keyCount].getData());
+	}
+
+	std::cout << "unordered_map<std::string> insert: ";
+	std::unordered_map<std::string, int> stdMap;
+	performanceTest([&keys, &stdMap]() {
+		stdMap.clear();
+		for (size_t i = 0; i < keys.size(); ++i) {
+			stdMap.emplace(std::string(keys[i].getData(), keys[i].length()), static_cast<int>(i));
+		}
+	}, 10);
+	std::cout << "unordered_map<MString> insert: ";
+	std::unordered_map<MString, int> mstringMap;
+	performanceTest([&keys, &mstringMap]() {
+		mstringMap.clear();
+		for (size_t i = 0; i < keys.size(); ++i) {
+			mstringMap.emplace(keys[i], static_cast<int>(i));
+		}
+	}, 10);
+	std::cout << "unordered_map<MStringKey> insert: ";
+	std::unordered_map<MStringKey, int> keyMap;
+	performanceTest([&keys, &keyMap]() {
+		keyMap.clear();
+		for (size_t i = 0; i < keys.size(); ++i) {
+			keyMap.emplace(MStringKey::ref(keys[i]), static_cast<int>(i));
+		}
+	}, 10);
+
+	std::cout << "unordered_map<std::string> find(const char*): ";
+	performanceTest([&lookups, &stdMap]() {
+		for (const char* key : lookups) {
+			sink += stdMap.find(key)->second;
+		}
+	}, 10);
+	std::cout << "unordered_map<MString> find(const char*): ";
+	performanceTest([&lookups, &mstringMap]() {
+		for (const char* key : lookups) {
+			sink += mstringMap.find(MString(key))->second;
+		}
+	}, 10);
+	std::cout << "unordered_map<MStringKey> find(MStringKey::ref): ";
+	performanceTest([&lookups, &keyMap]() {
+		for (const char* key : lookups) {
+			sink += keyMap.find(MStringKey::ref(key))->second;
+		}
+	}, 10);
+
+	// 同一个键重复查找：缓存的哈希值只计算一次
+	std::vector<MStringKey> cachedKeys;
+	for (int i = 0; i < 1000; ++i) {
+		cachedKeys.push_back(MStringKey(keys[(i * 31) % keyCount]));
+	}
+	std::cout << "unordered_map<MString> repeated find: ";
+	performanceTest([&keys, &mstringMap]() {
+		for (int i = 0; i < 1000; ++i) {
+			sink += mstringMap.find(keys[(i * 31) % keys.size()])->second;
+		}
+	}, 1000);
+	std::cout << "unordered_map<MStringKey> repeated find (cached hash): ";
+	performanceTest([&cachedKeys, &keyMap]() {
+		for (const MStringKey& key : cachedKeys) {
+			sink += keyMap.find(key)->second;
+		}
+	}, 1000);
+}
+
+// 大文件扫描性能测试：统计128MB日志中含"ERROR"的行数，对比getline、整体读入堆内存与内存映射逐行遍历
+void mappedFilePerformanceTest() {
+	const char* fileName = "mapped_file_test.log";
+	{
+		std::ofstream out(fileName, std::ios::binary);
+		MString line;
+		for (int i = 0; out.tellp() < 128 * 1024 * 1024; ++i) {
+			line = MString::format("2024-01-01 12:00:00.{} [{}] worker-{} handled request id={} cost={}ms\n",
+			                       i % 1000, i % 97 == 0 ? "ERROR" : "INFO", i % 16, i, i % 300);
+			out.write(line.getData(), line.length());
+		}
+	}
+	auto countTest = [](const char* name, std::function<size_t()> count) {
+		uint64_t startTime = getCurrentTimeMillis();
+		size_t lines = count();
+		std::cout << MString::format("{}: {} error lines, takes {} milliseconds", name, lines, getCurrentTimeMillis() - startTime) << std::endl;
+	};
+
+	countTest("std::getline", [fileName]() {
+		std::ifstream in(fileName, std::ios::binary);
+		std::string line;
+		size_t count = 0;
+		while (std::getline(in, line)) {
+			count += line.find("ERROR") != std::string::npos;
+		}
+		return count;
+	});
+	countTest("read into heap + splitBy", [fileName]() {
+		std::ifstream in(fileName, std::ios::binary | std::ios::ate);
+		std::vector<char> content(static_cast<size_t>(in.tellg()));
+		in.seekg(0);
+		in.read(content.data(), content.size());
+		size_t count = 0;
+		for (MStringView line : MStringView(content.data(), content.size()).splitBy('\n')) {
+			count += line.find("ERROR") >= 0;
+		}
+		return count;
+	});
+	countTest("MStringMappedFile::lines", [fileName]() {
+		MStringMappedFile file(fileName);
+		size_t count = 0;
+		for (MStringView line : file.lines()) {
+			count += line.find("ERROR") >= 0;
+		}
+		return count;
+	});
+	countTest("MStringMappedFile find", [fileName]() {
+		MStringMappedFile file(fileName);
+		MStringView text = file.view();
+		size_t count = 0;
+		for (int pos = text.find("ERROR"); pos >= 0; pos = text.find("ERROR", pos + 5)) {
+			count++;
+		}
+		return count;
+	});
+	std::remove(fileName);
+}
+
+// 绳索字符串性能测试：逐行拼装32MB报表、在中间插入，以及写入文件，对比连续的MString
+void ropePerformanceTest() {
+	static volatile size_t sink = 0;
+	const int lineCount = 400000;
+	MString line("member 123456 zhangsanfeng shenzhen-nanshan level=3 updated=2024-01-01 12:00:00\n");
+
+	MString text;
+	MStringRope rope;
+	std::cout << "MString += 32MB: ";
+	performanceTest([&text, &line]() {
+		text = MString();
+		for (int i = 0; i < lineCount; ++i) {
+			text += line;
+		}
+	}, 5);
+	std::cout << "MStringRope += 32MB: ";
+	performanceTest([&rope, &line]() {
+		rope = MStringRope();
+		for (int i = 0; i < lineCount; ++i) {
+			rope += line;
+		}
+	}, 5);
+
+	// 在报表中间插入1000段内容
+	MString section("==== section ====\n");
+	std::cout << "MString insert in middle: ";
+	performanceTest([&text, &section]() {
+		size_t pos = text.length() / 2;
+		text = text.left(pos) + section + text.mid(pos, text.length() - pos);
+	}, 100);
+	std::cout << "MStringRope insert in middle: ";
+	performanceTest([&rope, &section]() {
+		rope.insert(rope.length() / 2, MStringRope(section));
+	}, 1000);
+	std::cout << "MStringRope substring 1KB: ";
+	performanceTest([&rope]() {
+		sink += rope.substring(rope.length() / 3, 1024).length();
+	}, 100000);
+
+	const char* fileName = "rope_test.txt";
+	std::cout << "MStringRope flatten + fwrite: ";
+	performanceTest([&rope, fileName]() {
+		MString flat = rope.flatten();
+		FILE* file = fopen(fileName, "wb");
+		sink += fwrite(flat.getData(), 1, flat.length(), file);
+		fclose(file);
+	}, 10);
+	std::cout << "MStringRope writeTo(fd): ";
+	performanceTest([&rope, fileName]() {
+		FILE* file = fopen(fileName, "wb");
+#ifdef _WIN32
+		sink += rope.writeTo(_fileno(file));
+#else
+		sink += rope.writeTo(fileno(file));
+#endif
+		fclose(file);
+	}, 10);
+	std::remove(fileName);
+}
+
+// 批量排序性能测试：100万个带公共前缀的会员键，std::sort + compareTo 与基数排序对比（均含复制输入的耗时）
+void sortPerformanceTest() {
+	static volatile size_t sink = 0;
+	const int count = 1000000;
+	std::vector<MString> input;
+	input.reserve(count);
+	srand(12345);
+	for (int i = 0; i < count; ++i) {
+		input.push_back(MString("member:shenzhen:") + MString(rand() % 100000) + ":" + MString(rand()));
+	}
+
+	std::cout << "std::sort + compareTo: ";
+	performanceTest([&input]() {
+		std::vector<MString> strings(input);
+		std::sort(strings.begin(), strings.end(), [](const MString& a, const MString& b) {
+			return a.compareTo(b) < 0;
+		});
+		sink += strings.front().length();
+	}, 3);
+	std::cout << "MString::sort: ";
+	performanceTest([&input]() {
+		std::vector<MString> strings(input);
+		MString::sort(strings);
+		sink += strings.front().length();
+	}, 3);
+	std::cout << "MString::parallelSort: ";
+	performanceTest([&input]() {
+		std::vector<MString> strings(input);
+		MString::parallelSort(strings);
+		sink += strings.front().length();
+	}, 3);
+
+	// 排序后去重，以及4路归并
+	std::vector<std::vector<MString>> parts(4);
+	for (int i = 0; i < count; ++i) {
+		parts[i % 4].push_back(input[i]);
+	}
+	for (auto& part : parts) {
+		MString::sort(part);
+	}
+	std::cout << "MString::sort + uniqueSorted: ";
+	performanceTest([&input]() {
+		std::vector<MString> strings(input);
+		MString::sort(strings);
+		MString::uniqueSorted(strings);
+		sink += strings.size();
+	}, 3);
+	std::cout << "MString::mergeSorted 4 ways: ";
+	performanceTest([&parts]() {
+		sink += MString::mergeSorted(parts).size();
+	}, 3);
+}
+
+// 批量操作性能测试：100万条记录的转小写、过滤和替换，逐个生成MString与MString::batch对比
+void batchPerformanceTest() {
+	static volatile size_t sink = 0;
+	const int count = 1000000;
+	std::vector<MString> input;
+	input.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		input.push_back(MString("  Member ") + MString(i) + " ShenZhen-NanShan Level=" + MString(i % 7) + "  ");
+	}
+	// 并行效果取决于核数，随结果一起输出
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency()
+	          << ", parallel threshold: " << MString::batch::parallelThreshold() << std::endl;
+
+	std::cout << "serial toLowerCase: ";
+	performanceTest([&input]() {
+		std::vector<MString> result;
+		result.reserve(input.size());
+		for (const auto& str : input) {
+			result.push_back(str.toLowerCase());
+		}
+		sink += result.size();
+	}, 5);
+	std::cout << "MString::batch::toLowerCase: ";
+	performanceTest([&input]() {
+		sink += MString::batch::toLowerCase(input).dataLength();
+	}, 5);
+
+	std::cout << "serial trim: ";
+	performanceTest([&input]() {
+		std::vector<MString> result;
+		result.reserve(input.size());
+		for (const auto& str : input) {
+			result.push_back(str.trim());
+		}
+		sink += result.size();
+	}, 5);
+	std::cout << "MString::batch::trim: ";
+	performanceTest([&input]() {
+		sink += MString::batch::trim(input).dataLength();
+	}, 5);
+
+	std::cout << "serial contains filter: ";
+	performanceTest([&input]() {
+		std::vector<MString> result;
+		for (const auto& str : input) {
+			if (str.contains("Level=3")) {
+				result.push_back(str);
+			}
+		}
+		sink += result.size();
+	}, 5);
+	std::cout << "MString::batch::filterContains: ";
+	performanceTest([&input]() {
+		sink += MString::batch::filterContains(input, "Level=3").size();
+	}, 5);
+
+	std::cout << "serial replace: ";
+	performanceTest([&input]() {
+		std::vector<MString> result;
+		result.reserve(input.size());
+		for (const auto& str : input) {
+			result.push_back(str.replace("ShenZhen", "Guangdong ShenZhen"));
+		}
+		sink += result.size();
+	}, 5);
+	std::cout << "MString::batch::replace: ";
+	performanceTest([&input]() {
+		sink += MString::batch::replace(input, "ShenZhen", "Guangdong ShenZhen").dataLength();
+	}, 5);
+}
+
+// 数值转换性能测试：stringstream/stod 与 MStringNumber 对比
+void numberConvertPerformanceTest() {
+	static volatile size_t sink = 0;
+
+	std::cout << "std::stringstream long long -> string: ";
+	performanceTest([]() {
+		std::stringstream ss;
+		ss << 28810331651LL;
+		sink += ss.str().size();
+	});
+	std::cout << "MString = long long: ";
+	performanceTest([]() {
+		MString phone;
+		phone = 28810331651LL;
+		sink += phone.length();
+	});
+	std::cout << "std::stod -> long long: ";
+	performanceTest([]() {
+		sink += static_cast<long long>(std::stod(std::string("28810331651")));
+	});
+	std::cout << "MString -> long long: ";
+	MString phone("28810331651");
+	performanceTest([&phone]() {
+		long long value = phone;
+		sink += value;
+	});
+	std::cout << "MString = double: ";
+	performanceTest([]() {
+		MString price;
+		price = 3.1415926;
+		sink += price.length();
+	});
+	std::cout << "MString -> double: ";
+	MString price("3.1415926");
+	performanceTest([&price]() {
+		double value = price;
+		sink += static_cast<size_t>(value);
+	});
+}
+
 void stringFormatPerformanceTest() {
 	// MString format性能测试
 	auto formatLambda = []() {
 		return MString::format("{} {}: {}", "Set", "Index", 123);  // 执行格式化
 	};
+	std::cout << "MString::format: ";
 	performanceTest(formatLambda);
+
+	// 编译期解析格式串
+	auto compiledLambda = []() {
+		return MSTRING_FORMAT("{} {}: {}", "Set", "Index", 123);
+	};
+	std::cout << "MSTRING_FORMAT: ";
+	performanceTest(compiledLambda);
+
+	// 复用缓冲区：稳定状态下不分配内存
+	MString line;
+	std::cout << "MString::appendFormat: ";
+	performanceTest([&line]() {
+		line.clear();
+		line.appendFormat("{} {}: {:>6}", "Set", "Index", 123);
+	});
+	char buffer[64];
+	std::cout << "MStringFormat::formatTo char[64]: ";
+	performanceTest([&buffer]() {
+		MStringFormat::formatTo(buffer, "{} {}: {:08x}", "Set", "Index", 123);
+	});
+
+	// 参数引用目标字符串自身：追加时扩容不能使后续参数失效
+	std::cout << "MString::appendFormat self-reference: ";
+	performanceTest([]() {
+		MString self("0123456789abcdefghij0123456789");
+		self.appendFormat("{}|{}|{}|{}", self, self, self, self);
+		return self;
+	});
 }
 
 int main() {